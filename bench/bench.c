@@ -0,0 +1,843 @@
+/*
+ * bench.c
+ * Benchmarks of uqwordladder's hot paths
+ *
+ * The program is compiled in so its functions can be timed directly. Each
+ * dictionary given is loaded and timed case by case, printing one tab
+ * separated line per case: the case, the number of words loaded, the
+ * operations timed, nanoseconds per operation and the rate. The format is
+ * kept stable so results can be compared between versions. Cases playing
+ * games stop early once they have taken BENCH_BUDGET_NS, so very large
+ * dictionaries still finish in reasonable time.
+ */
+
+//main() never returns, which only main() may leave unsaid
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#define main uqwordladder_main
+#include "../uqWordLadder.c"
+#undef main
+#pragma GCC diagnostic pop
+
+// constants
+#define BENCH_SEED 1
+#define BENCH_CACHE "/nonexistent"
+#define BENCH_STARTUPS 5
+#define BENCH_OLD_WORD 50
+#define BENCH_LOOKUPS 1000000
+#define BENCH_SCANS 10000
+#define BENCH_PAIRS 4096
+#define BENCH_DIFFS 20000000
+#define BENCH_SUGGEST_GAMES 10000
+#define BENCH_SUGGESTIONS 10
+#define BENCH_GAMES 20000
+#define BENCH_HINT_EVERY 3
+#define BENCH_SOLVES 2000
+#define BENCH_BUDGET_NS 2000000000LL
+#define BENCH_HEADER "case\twords\tops\tns/op\trate\tunit\n"
+#define BENCH_RESULT "%s\t%d\t%lld\t%.1f\t%.1f\t%s\n"
+#define BENCH_USAGE "Usage: bench dictfile ...\n"
+
+/*Moves of one recorded game, ending on its target*/
+typedef struct {
+    char initWord[MAX_LENGTH + 1]; //initial word
+    char toWord[MAX_LENGTH + 1]; //target word
+    int moves; //number of moves
+    char words[MAX_STEP][MAX_LENGTH + 1]; //words entered in order
+} Record;
+
+//results the compiler can't see are unused, so nothing timed is dropped
+volatile long long benchSink;
+
+/* bench_report()
+* −−−−−−−−−−−−−−−
+* Prints the result line of one case
+*
+* name: name of the case
+* words: number of words in the dictionary
+* ops: number of operations timed
+* ns: nanoseconds taken by all of them
+* amount: amount done per second is the rate, e.g. ops or megabytes
+* unit: unit of the rate
+*
+* Returns: Nothing
+*/
+void bench_report(const char* name, int words, long long ops, long long ns,
+        double amount, const char* unit) {
+    double seconds = ns > 0 ? ns / 1e9 : 1e-9;
+    fprintf(stdout, BENCH_RESULT, name, words, ops, (double)ns / ops,
+            amount / seconds, unit);
+    fflush(stdout);
+}
+
+/* quiet_stdout()
+* −−−−−−−−−−−−−−−
+* Sends stdout to /dev/null while cases that print (e.g. the solver) run
+*
+* Returns: descriptor of the real stdout, for restore_stdout()
+*/
+int quiet_stdout(void) {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int null = open("/dev/null", O_WRONLY);
+    dup2(null, STDOUT_FILENO);
+    close(null);
+    return saved;
+}
+
+/* restore_stdout()
+* −−−−−−−−−−−−−−−
+* Puts back the stdout taken away by quiet_stdout()
+*
+* saved: descriptor of the real stdout
+*
+* Returns: Nothing
+*/
+void restore_stdout(int saved) {
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+}
+
+/* file_size()
+* −−−−−−−−−−−−−−−
+* Gets the size of a dictionary file
+*
+* path: dictionary file location
+*
+* Returns: number of bytes in the file, 0 if it can't be read
+*/
+long long file_size(const char* path) {
+    struct stat info;
+    return stat(path, &info) == 0 ? info.st_size : 0;
+}
+
+/* total_words()
+* −−−−−−−−−−−−−−−
+* Counts the words of every length
+*
+* dicts: dictionary of each word length
+*
+* Returns: number of words loaded
+*/
+int total_words(const Dict dicts[]) {
+    int words = 0;
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        words += dicts[length].wordsInDict;
+    }
+    return words;
+}
+
+/* random_word()
+* −−−−−−−−−−−−−−−
+* Picks a random word of any length, each word equally likely
+*
+* dicts: dictionary of each word length
+* words: number of words loaded
+* word: filled with the word
+*
+* Returns: Nothing
+*/
+void random_word(const Dict dicts[], int words, char word[MAX_LENGTH + 1]) {
+    int pick = rand() % words;
+    int length = MIN_LENGTH;
+    while (pick >= dicts[length].wordsInDict) {
+        pick -= dicts[length++].wordsInDict;
+    }
+    dict_word(&dicts[length], pick, word);
+}
+
+/* bench_load()
+* −−−−−−−−−−−−−−−
+* Times loading every word length from the file with no cache, in MB/s of
+* dictionary text
+*
+* path: dictionary file location
+* dicts: filled with the dictionary of each word length
+*
+* Returns: boolean if the dictionary file could be opened
+*/
+bool bench_load(const char* path, Dict dicts[]) {
+    long long start = stats_now();
+    if (load_dictionaries(dicts, path, MIN_LENGTH, MAX_LENGTH, true) == false) {
+        return false;
+    }
+    long long taken = stats_now() - start;
+    bench_report("load", total_words(dicts), 1, taken,
+            file_size(path) / 1e6, "MB/s");
+    return true;
+}
+
+/* text_index()
+* −−−−−−−−−−−−−−−
+* Lays the words of one length out the way the dictionary was held before
+* words were packed into codes: null terminated text, one word after
+* another, with an open addressing hash set of their indexes
+*
+* dict: dictionary of one word length
+* text: filled with the words
+* slots: filled with the hash set, EMPTY_SLOT if free
+*
+* Returns: number of slots in the hash set (power of 2)
+*/
+unsigned int text_index(const Dict* dict, char** text, int** slots) {
+    unsigned int stride = dict->wordLen + 1;
+    unsigned int size = index_size(dict->wordsInDict);
+    *text = malloc((size_t)stride * (dict->wordsInDict + 1));
+    *slots = malloc(sizeof(int) * size);
+    memset(*slots, 0xff, sizeof(int) * size);
+    for (int i = 0; i < dict->wordsInDict; i++) {
+        char* word = dict_word(dict, i, *text + (size_t)i * stride);
+        unsigned int slot = hash_word(word) & (size - 1);
+        while ((*slots)[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & (size - 1);
+        }
+        (*slots)[slot] = i;
+    }
+    return size;
+}
+
+/* text_lookup()
+* −−−−−−−−−−−−−−−
+* Looks a word up the way in_dict() did before words were packed into
+* codes, hashing its text and comparing it with strcmp()
+*
+* word: given uppercase word to find
+* text: words of its length laid out by text_index()
+* slots: hash set of their indexes
+* size: number of slots
+*
+* Returns: boolean if word in dictionary
+*/
+bool text_lookup(const char* word, const char* text, const int* slots,
+        unsigned int size) {
+    size_t stride = strlen(word) + 1;
+    //linear probing until the word or an empty slot is found
+    for (unsigned int slot = hash_word(word) & (size - 1);;
+            slot = (slot + 1) & (size - 1)) {
+        int index = slots[slot];
+        if (index == EMPTY_SLOT) {
+            return false;
+        }
+        if (strcmp(word, text + index * stride) == 0) {
+            return true;
+        }
+    }
+}
+
+/* bsearch_lookup()
+* −−−−−−−−−−−−−−−
+* Looks a word up by binary search over the sorted codes, as in_dict() did
+* before the codes were hash indexed
+*
+* word: given uppercase word to find
+* dict: dictionary of its length
+*
+* Returns: boolean if word in dictionary
+*/
+bool bsearch_lookup(const char* word, const Dict* dict) {
+    uint64_t code = word_code(word);
+    return code != 0 && bsearch(&code, dict->codes, dict->wordsInDict,
+            sizeof(uint64_t), compare_codes) != NULL;
+}
+
+/* bench_lookup()
+* −−−−−−−−−−−−−−−
+* Times membership lookups of words of every length, half of them words of
+* the dictionary and half with a letter changed, which mostly aren't. The
+* same lookups are then timed against the hashed text the dictionary was
+* held as before, and by binary search over the codes.
+*
+* dicts: dictionary of each word length
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_lookup(const Dict dicts[], int words) {
+    char (*queries)[MAX_LENGTH + 1] = malloc(sizeof(*queries)
+            * BENCH_LOOKUPS);
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        random_word(dicts, words, queries[i]);
+        if (i % 2 == 1) {
+            int letter = rand() % strlen(queries[i]);
+            queries[i][letter] = 'A' + rand() % ALPHABET;
+        }
+    }
+    long long found = 0;
+    long long start = stats_now();
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        found += in_dict(queries[i], &dicts[strlen(queries[i])]);
+    }
+    long long taken = stats_now() - start;
+    bench_report("lookup", words, BENCH_LOOKUPS, taken, BENCH_LOOKUPS,
+            "ops/s");
+    char* text[MAX_LENGTH + 1];
+    int* slots[MAX_LENGTH + 1];
+    unsigned int size[MAX_LENGTH + 1];
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        size[length] = text_index(&dicts[length], &text[length],
+                &slots[length]);
+    }
+    start = stats_now();
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        unsigned int length = strlen(queries[i]);
+        found += text_lookup(queries[i], text[length], slots[length],
+                size[length]);
+    }
+    taken = stats_now() - start;
+    bench_report("lookup-text", words, BENCH_LOOKUPS, taken, BENCH_LOOKUPS,
+            "ops/s");
+    start = stats_now();
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        found += bsearch_lookup(queries[i], &dicts[strlen(queries[i])]);
+    }
+    taken = stats_now() - start;
+    bench_report("lookup-bsearch", words, BENCH_LOOKUPS, taken,
+            BENCH_LOOKUPS, "ops/s");
+    benchSink += found;
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        free(text[length]);
+        free(slots[length]);
+    }
+    free(queries);
+}
+
+/* bench_ingest()
+* −−−−−−−−−−−−−−−
+* Times packing the words of every length out of the dictionary text
+* already in memory, in MB/s, with one thread per processor and then with
+* a single thread
+*
+* path: dictionary file location
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_ingest(const char* path, int words) {
+    int file = open(path, O_RDONLY);
+    if (file == -1) {
+        return;
+    }
+    bool mapped;
+    size_t size;
+    char* text = read_file(file, true, &size, &mapped);
+    close(file);
+    for (int threaded = 1; threaded >= 0; threaded--) {
+        Dict dicts[MAX_LENGTH + 1];
+        memset(dicts, 0, sizeof(dicts));
+        long long start = stats_now();
+        if (threaded == 1) {
+            pack_parallel(dicts, MIN_LENGTH, MAX_LENGTH, text, size);
+        } else {
+            pack_words(dicts, MIN_LENGTH, MAX_LENGTH, text, size);
+        }
+        long long taken = stats_now() - start;
+        for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+            //a single thread leaves the codes outside the arena
+            if (threaded == 0) {
+                free(dicts[length].codes);
+            }
+            free_dict(&dicts[length]);
+        }
+        bench_report(threaded ? "ingest" : "ingest-1thread", words, 1,
+                taken, size / 1e6, "MB/s");
+    }
+    if (mapped == true) {
+        munmap(text, size);
+    } else {
+        free(text);
+    }
+}
+
+/* bench_load_lengths()
+* −−−−−−−−−−−−−−−
+* Times loading every word length by reading the file once per length, as
+* a service had to before one pass loaded them all, to compare with the
+* single pass timed by bench_load()
+*
+* path: dictionary file location
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_load_lengths(const char* path, int words) {
+    Dict dicts[MAX_LENGTH + 1];
+    long long start = stats_now();
+    for (unsigned int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        load_dictionaries(dicts, path, length, length, true);
+    }
+    long long taken = stats_now() - start;
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        free_dict(&dicts[length]);
+    }
+    bench_report("load-per-length", words, 1, taken, file_size(path) / 1e6,
+            "MB/s");
+}
+
+/* old_load()
+* −−−−−−−−−−−−−−−
+* Loads the words of one length the way read_dictionary() did before the
+* single pass loader: a line at a time with fgets(), growing the word list
+* by one with realloc() and copying each word with strdup()
+*
+* path: dictionary file location
+* length: word length kept
+* words: filled with the words, each allocated on its own
+*
+* Returns: number of words loaded
+*/
+int old_load(const char* path, unsigned int length, char*** words) {
+    FILE* file = fopen(path, "r");
+    int count = 0;
+    *words = NULL;
+    if (file == NULL) {
+        return 0;
+    }
+    char word[BENCH_OLD_WORD + 1];
+    while (fgets(word, sizeof(word), file) != NULL) {
+        if (strlen(word) > 0 && word[strlen(word) - 1] == '\n') {
+            word[strlen(word) - 1] = '\0';
+        }
+        if (strlen(word) == length && check_chars(word)) {
+            *words = realloc(*words, sizeof(char*) * (count + 1));
+            make_caps(word);
+            (*words)[count++] = strdup(word);
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+/* pack_only()
+* −−−−−−−−−−−−−−−
+* Reads and packs the words of one length with the single pass loader and
+* sorts them, without building the neighbour graph, so it does the same
+* work as old_load() plus dropping duplicates
+*
+* path: dictionary file location
+* dicts: filled with the dictionary of the length
+* length: word length kept
+*
+* Returns: Nothing
+*/
+void pack_only(const char* path, Dict dicts[], unsigned int length) {
+    memset(&dicts[length], 0, sizeof(Dict));
+    dicts[length].wordLen = length;
+    int file = open(path, O_RDONLY);
+    if (file == -1) {
+        return;
+    }
+    bool mapped;
+    size_t size;
+    char* text = read_file(file, true, &size, &mapped);
+    close(file);
+    pack_parallel(dicts, length, length, text, size);
+    if (mapped == true) {
+        munmap(text, size);
+    } else {
+        free(text);
+    }
+    sort_dictionary(&dicts[length]);
+}
+
+/* bench_startup()
+* −−−−−−−−−−−−−−−
+* Times loading the one word length a game is played at, which is what a
+* game waits for at startup, with no cache: the whole load, then the single
+* pass loader alone and then the old line by line loader
+*
+* path: dictionary file location
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_startup(const char* path, int words) {
+    long long taken = 0;
+    for (int i = 0; i < BENCH_STARTUPS; i++) {
+        Dict dicts[MAX_LENGTH + 1];
+        long long start = stats_now();
+        load_dictionaries(dicts, path, DEF_LENGTH, DEF_LENGTH, true);
+        taken += stats_now() - start;
+        free_dict(&dicts[DEF_LENGTH]);
+    }
+    bench_report("startup", words, BENCH_STARTUPS, taken, BENCH_STARTUPS,
+            "loads/s");
+    taken = 0;
+    for (int i = 0; i < BENCH_STARTUPS; i++) {
+        Dict dicts[MAX_LENGTH + 1];
+        long long start = stats_now();
+        pack_only(path, dicts, DEF_LENGTH);
+        taken += stats_now() - start;
+        free_dict(&dicts[DEF_LENGTH]);
+    }
+    bench_report("startup-pack", words, BENCH_STARTUPS, taken,
+            BENCH_STARTUPS, "loads/s");
+    taken = 0;
+    for (int i = 0; i < BENCH_STARTUPS; i++) {
+        char** list;
+        long long start = stats_now();
+        int count = old_load(path, DEF_LENGTH, &list);
+        taken += stats_now() - start;
+        for (int w = 0; w < count; w++) {
+            free(list[w]);
+        }
+        free(list);
+    }
+    bench_report("startup-fgets", words, BENCH_STARTUPS, taken,
+            BENCH_STARTUPS, "loads/s");
+}
+
+/* scan_lookup()
+* −−−−−−−−−−−−−−−
+* Looks a word up the way in_dict() did before the dictionary was indexed,
+* comparing it with every word of its length in turn
+*
+* word: given uppercase word to find
+* words: words of its length, each allocated on its own
+* count: number of words
+*
+* Returns: boolean if word in dictionary
+*/
+bool scan_lookup(const char* word, char** words, int count) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(word, words[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* bench_lookup_scan()
+* −−−−−−−−−−−−−−−
+* Times the same mix of lookups as bench_lookup() against the linear scan
+* it replaced, over word lists laid out as the old loader left them
+*
+* dicts: dictionary of each word length
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_lookup_scan(const Dict dicts[], int words) {
+    char** lists[MAX_LENGTH + 1];
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        const Dict* dict = &dicts[length];
+        lists[length] = malloc(sizeof(char*) * (dict->wordsInDict + 1));
+        for (int i = 0; i < dict->wordsInDict; i++) {
+            char word[MAX_LENGTH + 1];
+            lists[length][i] = strdup(dict_word(dict, i, word));
+        }
+    }
+    char query[MAX_LENGTH + 1];
+    long long found = 0;
+    long long taken = 0;
+    int ops = 0;
+    while (ops < BENCH_SCANS && taken < BENCH_BUDGET_NS) {
+        random_word(dicts, words, query);
+        if (ops % 2 == 1) {
+            query[rand() % strlen(query)] = 'A' + rand() % ALPHABET;
+        }
+        unsigned int length = strlen(query);
+        long long start = stats_now();
+        found += scan_lookup(query, lists[length],
+                dicts[length].wordsInDict);
+        taken += stats_now() - start;
+        ops++;
+    }
+    benchSink += found;
+    bench_report("lookup-scan", words, ops, taken, ops, "ops/s");
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        for (int i = 0; i < dicts[length].wordsInDict; i++) {
+            free(lists[length][i]);
+        }
+        free(lists[length]);
+    }
+}
+
+/* old_letter_diff()
+* −−−−−−−−−−−−−−−
+* Checks words for one letter difference the way one_letter_diff() first
+* did, working out the length on every letter and never stopping early
+*
+* word1: given word to check
+* word2: given word to check against
+*
+* Returns: boolean the 2 words are only 1 letter different
+*/
+bool old_letter_diff(const char* word1, const char* word2) {
+    int diff = 0;
+    for (size_t i = 0; i < strlen(word1); i++) {
+        if (word1[i] != word2[i]) {
+            diff++;
+        }
+    }
+    return diff == 1;
+}
+
+/* bench_diff()
+* −−−−−−−−−−−−−−−
+* Times one_letter_diff() and the function it replaced on the same pairs of
+* words of every length, half of them one letter apart and half any two
+* words of the same length
+*
+* dicts: dictionary of each word length
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_diff(const Dict dicts[], int words) {
+    char (*pairs)[2][MAX_LENGTH + 1] = malloc(sizeof(*pairs) * BENCH_PAIRS);
+    for (int i = 0; i < BENCH_PAIRS; i++) {
+        random_word(dicts, words, pairs[i][0]);
+        unsigned int length = strlen(pairs[i][0]);
+        if (i % 2 == 0) {
+            strcpy(pairs[i][1], pairs[i][0]);
+            pairs[i][1][rand() % length] = 'A' + rand() % ALPHABET;
+        } else {
+            dict_word(&dicts[length], rand() % dicts[length].wordsInDict,
+                    pairs[i][1]);
+        }
+    }
+    long long found = 0;
+    long long start = stats_now();
+    for (int i = 0; i < BENCH_DIFFS; i++) {
+        found += one_letter_diff(pairs[i % BENCH_PAIRS][0],
+                pairs[i % BENCH_PAIRS][1]);
+    }
+    long long taken = stats_now() - start;
+    bench_report("diff", words, BENCH_DIFFS, taken, BENCH_DIFFS, "ops/s");
+    start = stats_now();
+    for (int i = 0; i < BENCH_DIFFS; i++) {
+        found += old_letter_diff(pairs[i % BENCH_PAIRS][0],
+                pairs[i % BENCH_PAIRS][1]);
+    }
+    taken = stats_now() - start;
+    bench_report("diff-old", words, BENCH_DIFFS, taken, BENCH_DIFFS,
+            "ops/s");
+    benchSink += found;
+    free(pairs);
+}
+
+/* bench_suggest()
+* −−−−−−−−−−−−−−−
+* Times working out the suggestions for a "?" from random words of games
+* with random puzzles, including each game's first search back from its
+* target
+*
+* dict: dictionary of the game's word length, with its start words found
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_suggest(const Dict* dict, int words) {
+    Game game;
+    memset(&game, 0, sizeof(game));
+    char previous[BENCH_SUGGESTIONS][MAX_LENGTH + 1];
+    long long taken = 0;
+    long long ops = 0;
+    for (int g = 0; g < BENCH_SUGGEST_GAMES && taken < BENCH_BUDGET_NS;
+            g++) {
+        game_init(&game, dict, DEF_STEP, NULL);
+        if (pick_words(&game, dict->wordLen) == false) {
+            break;
+        }
+        for (int i = 0; i < BENCH_SUGGESTIONS; i++) {
+            dict_word(dict, rand() % dict->wordsInDict, previous[i]);
+        }
+        long long start = stats_now();
+        for (int i = 0; i < BENCH_SUGGESTIONS; i++) {
+            build_suggestions(&game, previous[i]);
+        }
+        taken += stats_now() - start;
+        ops += BENCH_SUGGESTIONS;
+    }
+    game_free(&game);
+    if (ops > 0) {
+        bench_report("suggest", words, ops, taken, ops, "ops/s");
+    }
+}
+
+/* make_record()
+* −−−−−−−−−−−−−−−
+* Makes a game by walking randomly from a random word without revisiting
+* words, the last word reached being the target
+*
+* dict: dictionary of the game's word length, with its start words found
+* record: filled with the game
+*
+* Returns: boolean if the walk took a step
+*/
+bool make_record(const Dict* dict, Record* record) {
+    int word = random_start(dict);
+    if (word == EMPTY_SLOT) {
+        return false;
+    }
+    int walk[MAX_STEP + 1];
+    int walked = 0;
+    walk[walked++] = word;
+    dict_word(dict, word, record->initWord);
+    while (walked < DEF_STEP) {
+        int fresh[MAX_NEIGHBOURS];
+        int count = 0;
+        for (int n = dict->neighStart[word]; n < dict->neighStart[word + 1];
+                n++) {
+            bool seen = false;
+            for (int w = 0; w < walked; w++) {
+                seen = seen || walk[w] == dict->neighbours[n];
+            }
+            if (!seen) {
+                fresh[count++] = dict->neighbours[n];
+            }
+        }
+        if (count == 0) {
+            break;
+        }
+        word = fresh[rand() % count];
+        dict_word(dict, word, record->words[walked - 1]);
+        walk[walked++] = word;
+    }
+    record->moves = walked - 1;
+    if (record->moves == 0) {
+        return false;
+    }
+    strcpy(record->toWord, record->words[record->moves - 1]);
+    return true;
+}
+
+/* bench_replay()
+* −−−−−−−−−−−−−−−
+* Times whole games played to the target, with a "?" before every few
+* moves, the way --batch and the server play them
+*
+* dict: dictionary of the game's word length, with its start words found
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_replay(const Dict* dict, int words) {
+    Record* records = malloc(sizeof(Record) * BENCH_GAMES);
+    int games = 0;
+    while (games < BENCH_GAMES && make_record(dict, &records[games])) {
+        games++;
+    }
+    FILE* discard = fopen("/dev/null", "w");
+    Game game;
+    memset(&game, 0, sizeof(game));
+    long long won = 0;
+    long long start = stats_now();
+    int played = 0;
+    while (played < games && stats_now() - start < BENCH_BUDGET_NS) {
+        Record* record = &records[played++];
+        game_init(&game, dict, DEF_STEP, discard);
+        strcpy(game.initWord, record->initWord);
+        strcpy(game.toWord, record->toWord);
+        for (int m = 0; m < record->moves; m++) {
+            if (m % BENCH_HINT_EVERY == 0) {
+                check_input("?", &game);
+            }
+            check_input(record->words[m], &game);
+        }
+        won += game.result == 0;
+    }
+    long long taken = stats_now() - start;
+    benchSink += won;
+    if (played > 0) {
+        bench_report("replay", words, played, taken, played, "games/s");
+    }
+    game_free(&game);
+    fclose(discard);
+    free(records);
+}
+
+/* bench_solve()
+* −−−−−−−−−−−−−−−
+* Times the solver on random puzzles made as the game makes them, allowing
+* the longest step limit
+*
+* dict: dictionary of the game's word length, with its start words found
+* words: number of words loaded
+*
+* Returns: Nothing
+*/
+void bench_solve(const Dict* dict, int words) {
+    Record* puzzles = malloc(sizeof(Record) * BENCH_SOLVES);
+    Game game;
+    memset(&game, 0, sizeof(game));
+    int solves = 0;
+    while (solves < BENCH_SOLVES) {
+        game_init(&game, dict, MAX_STEP, NULL);
+        if (pick_words(&game, dict->wordLen) == false) {
+            break;
+        }
+        strcpy(puzzles[solves].initWord, game.initWord);
+        strcpy(puzzles[solves++].toWord, game.toWord);
+    }
+    long long solved = 0;
+    int saved = quiet_stdout();
+    long long begin = stats_now();
+    int done = 0;
+    while (done < solves && stats_now() - begin < BENCH_BUDGET_NS) {
+        game_init(&game, dict, MAX_STEP, stdout);
+        strcpy(game.initWord, puzzles[done].initWord);
+        strcpy(game.toWord, puzzles[done++].toWord);
+        solved += solve_ladder(&game) == 0;
+    }
+    long long taken = stats_now() - begin;
+    restore_stdout(saved);
+    benchSink += solved;
+    if (done > 0) {
+        bench_report("solve", words, done, taken, done, "solves/s");
+    }
+    game_free(&game);
+    free(puzzles);
+}
+
+/* bench_dictionary()
+* −−−−−−−−−−−−−−−
+* Runs every case against one dictionary file. Games are played at the
+* default word length.
+*
+* path: dictionary file location
+*
+* Returns: boolean if the dictionary file could be opened
+*/
+bool bench_dictionary(const char* path) {
+    Dict dicts[MAX_LENGTH + 1];
+    memset(dicts, 0, sizeof(dicts));
+    srand(BENCH_SEED);
+    if (bench_load(path, dicts) == false) {
+        return false;
+    }
+    int words = total_words(dicts);
+    bench_ingest(path, words);
+    bench_load_lengths(path, words);
+    bench_startup(path, words);
+    Dict* dict = &dicts[DEF_LENGTH];
+    find_starts(dict);
+    bench_lookup(dicts, words);
+    bench_lookup_scan(dicts, words);
+    bench_diff(dicts, words);
+    bench_suggest(dict, words);
+    bench_replay(dict, words);
+    bench_solve(dict, words);
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        free_dict(&dicts[length]);
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, BENCH_USAGE);
+        return USAGE_ERROR_CODE;
+    }
+    //every load is timed cold, nothing is cached between runs
+    setenv(CACHE_ENV, BENCH_CACHE, 1);
+    fprintf(stdout, BENCH_HEADER);
+    for (int i = 1; i < argc; i++) {
+        if (bench_dictionary(argv[i]) == false) {
+            fprintf(stderr, FILE_NOT_OPENING, argv[i]);
+            return FILE_ERROR_CODE;
+        }
+    }
+    return 0;
+}
\ No newline at end of file
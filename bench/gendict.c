@@ -0,0 +1,116 @@
+/*
+ * gendict.c
+ * Synthetic dictionary generator for the uqwordladder benchmarks
+ *
+ * Writes the given number of lines to stdout, one word a line. Words are 2
+ * to 9 letters drawn with English letter frequencies, so the one letter
+ * graph is about as dense as a real dictionary's. Like a real dictionary,
+ * some lines are capitalised, possessive or too long, so the loader's
+ * filtering is timed too. The same size and seed always give the same file.
+ */
+
+// includes
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// constants
+#define DEF_SEED 1
+#define MAX_LINE 16
+#define LONG_LENGTH 10
+#define OUTPUT_BUFFER 65536
+#define CAPITAL_PERCENT 10
+#define POSSESSIVE_PERCENT 5
+#define USAGE "Usage: gendict words [seed]\n"
+
+//letters in English text per thousand, A to Z
+static const int letterWeights[] = {82, 15, 28, 43, 127, 22, 20, 61, 70, 2,
+        8, 40, 24, 67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1};
+
+//lines of each length per hundred, index 0 for lines too long to be words
+static const int lengthWeights[] = {13, 0, 1, 4, 10, 14, 16, 16, 14, 12};
+
+/* next_random()
+* −−−−−−−−−−−−−−−
+* Steps the splitmix64 generator, which gives the same sequence on every
+* platform unlike rand()
+*
+* state: generator state
+*
+* Returns: next random number
+*/
+uint64_t next_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/* pick_weighted()
+* −−−−−−−−−−−−−−−
+* Picks an index with probability proportional to its weight
+*
+* weights: weight of each index
+* count: number of weights
+* state: generator state
+*
+* Returns: index picked
+*/
+int pick_weighted(const int* weights, int count, uint64_t* state) {
+    int total = 0;
+    for (int i = 0; i < count; i++) {
+        total += weights[i];
+    }
+    int pick = next_random(state) % total;
+    int i = 0;
+    while (pick >= weights[i]) {
+        pick -= weights[i++];
+    }
+    return i;
+}
+
+/* make_line()
+* −−−−−−−−−−−−−−−
+* Makes one line of the dictionary
+*
+* line: filled with the null terminated line
+* state: generator state
+*
+* Returns: Nothing
+*/
+void make_line(char line[MAX_LINE], uint64_t* state) {
+    int length = pick_weighted(lengthWeights, sizeof(lengthWeights)
+            / sizeof(int), state);
+    if (length == 0) {
+        length = LONG_LENGTH + next_random(state) % (MAX_LINE - 3
+                - LONG_LENGTH);
+    }
+    for (int i = 0; i < length; i++) {
+        line[i] = 'a' + pick_weighted(letterWeights, sizeof(letterWeights)
+                / sizeof(int), state);
+    }
+    line[length] = '\0';
+    int kind = next_random(state) % 100;
+    if (kind < CAPITAL_PERCENT) {
+        line[0] += 'A' - 'a';
+    } else if (kind < CAPITAL_PERCENT + POSSESSIVE_PERCENT) {
+        strcpy(line + length, "'s");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3 || atol(argv[1]) <= 0) {
+        fprintf(stderr, USAGE);
+        return 1;
+    }
+    long lines = atol(argv[1]);
+    uint64_t state = argc == 3 ? strtoull(argv[2], NULL, 10) : DEF_SEED;
+    setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER);
+    char line[MAX_LINE];
+    for (long i = 0; i < lines; i++) {
+        make_line(line, &state);
+        fprintf(stdout, "%s\n", line);
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*
+ * alloc_test.c
+ * Checks that playing a game allocates nothing once its arena has grown
+ *
+ * The program is compiled in, and is linked with malloc(), calloc() and
+ * realloc() wrapped (-Wl,--wrap) so every call it makes is counted. Each
+ * game is played once to warm its arena up, then again on the same Game,
+ * moves, mistakes and "?" alike. The second time round must not allocate.
+ */
+
+//main() never returns, which only main() may leave unsaid
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#define main uqwordladder_main
+#include "../uqWordLadder.c"
+#undef main
+#pragma GCC diagnostic pop
+
+// constants
+#define TEST_CACHE "/nonexistent"
+#define TEST_DICT "/tmp/uqwordladder-alloc-XXXXXX"
+#define TEST_ROUNDS 2
+
+//dictionary the games are played with
+static const char* testWords[] = {"cod", "cold", "cord", "card", "ward",
+        "warm", "word", "worm", "wore", "core", "care", "bore", "bare",
+        "Bard", "cards"};
+
+/*One game and everything entered while playing it*/
+typedef struct {
+    bool edit; //if steps may change the word length
+    const char* initWord; //initial word
+    const char* toWord; //target word
+    const char* inputs[16]; //lines entered, ending with NULL
+} TestGame;
+
+//every kind of line check_input() answers, ending on a win
+static const TestGame testGames[] = {
+    {false, "COLD", "WARM", {"?", "COLDS", "C0RD", "CARD", "XOLD", "CORD",
+            "?", "COLD", "?", "CARD", "WARD", "?", "WARM", NULL}},
+    {false, "BORE", "CARD", {"?", "BARE", "?", "CARE", "CARD", NULL}},
+    {true, "COD", "CARD", {"?", "COLD", "?", "CORD", "?", "CARD", NULL}},
+};
+
+//calls made by the program since the count was last cleared
+long long allocations;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size) {
+    allocations++;
+    return __real_realloc(pointer, size);
+}
+
+/* write_dictionary()
+* −−−−−−−−−−−−−−−
+* Writes the test dictionary to a new temporary file
+*
+* path: filled with the file's location
+*
+* Returns: boolean if the file was written
+*/
+bool write_dictionary(char path[PATH_MAX]) {
+    strcpy(path, TEST_DICT);
+    int file = mkstemp(path);
+    if (file == -1) {
+        return false;
+    }
+    FILE* out = fdopen(file, "w");
+    for (size_t i = 0; i < sizeof(testWords) / sizeof(testWords[0]); i++) {
+        fprintf(out, "%s\n", testWords[i]);
+    }
+    return fclose(out) == 0;
+}
+
+/* play_game()
+* −−−−−−−−−−−−−−−
+* Plays one test game through to its end
+*
+* game: game reused for every test game
+* dicts: dictionary of each word length, ANY_LENGTH too
+* test: game to play
+* out: where game messages are printed
+*
+* Returns: boolean if the game was won
+*/
+bool play_game(Game* game, const Dict dicts[], const TestGame* test,
+        FILE* out) {
+    game_init(game, &dicts[test->edit ? ANY_LENGTH : strlen(test->initWord)],
+            DEF_STEP, out);
+    strcpy(game->initWord, test->initWord);
+    strcpy(game->toWord, test->toWord);
+    for (int i = 0; test->inputs[i] != NULL; i++) {
+        check_input(test->inputs[i], game);
+    }
+    return game->result == 0;
+}
+
+int main(void) {
+    setenv(CACHE_ENV, TEST_CACHE, 1);
+    char path[PATH_MAX];
+    if (write_dictionary(path) == false) {
+        fprintf(stderr, "alloc_test: can't write %s\n", path);
+        return 1;
+    }
+    Dict dicts[MAX_LENGTH + 1];
+    memset(dicts, 0, sizeof(dicts));
+    bool loaded = load_dictionaries(dicts, path, MIN_LENGTH, MAX_LENGTH,
+            true);
+    unlink(path);
+    if (loaded == false) {
+        fprintf(stderr, "alloc_test: can't load %s\n", path);
+        return 1;
+    }
+    build_edit_dict(dicts);
+    FILE* discard = fopen("/dev/null", "w");
+    Game game;
+    memset(&game, 0, sizeof(game));
+    int failed = 0;
+    for (int round = 0; round < TEST_ROUNDS; round++) {
+        for (size_t i = 0; i < sizeof(testGames) / sizeof(testGames[0]);
+                i++) {
+            allocations = 0;
+            bool won = play_game(&game, dicts, &testGames[i], discard);
+            //only the first round may grow the arena
+            if (won == false || (round > 0 && allocations != 0)) {
+                fprintf(stderr, "alloc_test: %s to %s %s, %lld allocations"
+                        " in round %d\n", testGames[i].initWord,
+                        testGames[i].toWord, won ? "won" : "not won",
+                        allocations, round + 1);
+                failed++;
+            }
+        }
+    }
+    fclose(discard);
+    game_free(&game);
+    for (int length = 0; length <= MAX_LENGTH; length++) {
+        free_dict(&dicts[length]);
+    }
+    fprintf(stdout, "alloc_test: %s\n", failed == 0 ? "passed" : "FAILED");
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,332 @@
+/*
+ * reload_stress.c
+ * Hammers the server with games while its dictionary is reloaded
+ *
+ * The program is compiled in and its server is forked off on a socket.
+ * Client threads play short games with "?" over and over while another
+ * thread keeps rewriting the dictionary file in place, alternately growing
+ * and shrinking it, and sending the server SIGHUP. Every game must be won
+ * and the server must still be running at the end. Then one word is added
+ * and taken away again: a new game must accept it once it is added, and a
+ * game started before it was taken away must still accept it.
+ */
+
+//main() never returns, which only main() may leave unsaid
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#define main uqwordladder_main
+#include "../uqWordLadder.c"
+#undef main
+#pragma GCC diagnostic pop
+
+// includes
+#include <sys/wait.h>
+
+// constants
+#define STRESS_CACHE "/nonexistent"
+#define STRESS_DICT "/tmp/uqwordladder-reload-XXXXXX"
+#define STRESS_SOCKET "%s.sock"
+#define STRESS_SEED 1
+#define STRESS_FILLER 50000
+#define STRESS_CLIENTS 6
+#define STRESS_RELOADS 100
+#define STRESS_RELOAD_US 20000
+#define STRESS_WAIT_US 10000
+#define STRESS_WAITS 500
+#define STRESS_OPTIONS "--init warm --target ward\n"
+#define STRESS_GAME STRESS_OPTIONS "?\nward\n"
+#define STRESS_WON "Well done"
+#define STRESS_VERSIONED "wars"
+#define STRESS_STARTED "Enter word 1"
+#define STRESS_MOVED "Enter word 2"
+#define STRESS_REPLY 65536
+
+//words every version of the dictionary has, so the game is always winnable,
+//and only the versions with filler also have STRESS_VERSIONED
+static const char* stressWords[] = {"cold", "cord", "card", "ward", "warm",
+        "word", "worm"};
+
+//where the server listens
+struct sockaddr_un serverAddress;
+
+//games played and games not won, by every client
+int played;
+int lost;
+
+//reloads the server has been sent, the clients stop after the last
+int reloads;
+
+//process the server runs in
+pid_t serverPid;
+
+/* write_dictionary()
+* −−−−−−−−−−−−−−−
+* Rewrites the dictionary file in place, with or without filler words. It
+* is overwritten from the start and then cut to length rather than emptied
+* first, so a reload always sees the words the games are played with.
+*
+* path: dictionary file location
+* filler: if STRESS_VERSIONED and random filler words are added
+*
+* Returns: boolean if the file was written
+*/
+bool write_dictionary(const char* path, bool filler) {
+    FILE* out = fopen(path, "r+");
+    if (out == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(stressWords) / sizeof(stressWords[0]);
+            i++) {
+        fprintf(out, "%s\n", stressWords[i]);
+    }
+    if (filler) {
+        fprintf(out, "%s\n", STRESS_VERSIONED);
+    }
+    //the same filler every time, so reloads only shrink and grow the file
+    unsigned int seed = STRESS_SEED;
+    for (int i = 0; filler && i < STRESS_FILLER; i++) {
+        char word[MAX_LENGTH + 1];
+        int length = MIN_LENGTH + rand_r(&seed) % (MAX_LENGTH - MIN_LENGTH);
+        for (int letter = 0; letter < length; letter++) {
+            word[letter] = 'a' + rand_r(&seed) % ALPHABET;
+        }
+        word[length] = '\0';
+        fprintf(out, "%s\n", word);
+    }
+    bool written = fflush(out) == 0
+            && ftruncate(fileno(out), ftell(out)) == 0;
+    return fclose(out) == 0 && written;
+}
+
+/* connect_server()
+* −−−−−−−−−−−−−−−
+* Connects to the server and sends the first lines of a game
+*
+* lines: lines to send
+*
+* Returns: connection to the server or -1 if it can't be made
+*/
+int connect_server(const char* lines) {
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connect(server, (struct sockaddr*)&serverAddress,
+            sizeof(serverAddress)) == -1 || write(server, lines,
+            strlen(lines)) == -1) {
+        close(server);
+        return -1;
+    }
+    return server;
+}
+
+/* read_reply()
+* −−−−−−−−−−−−−−−
+* Reads from the server until the expected text arrives or it hangs up
+*
+* server: connection to the server
+* reply: filled with everything read
+* expected: text waited for, NULL to read until the server hangs up
+*
+* Returns: boolean if the expected text arrived, or if anything did
+*/
+bool read_reply(int server, char reply[STRESS_REPLY], const char* expected) {
+    size_t size = 0;
+    ssize_t got;
+    reply[0] = '\0';
+    while ((expected == NULL || strstr(reply, expected) == NULL)
+            && size < STRESS_REPLY - 1 && (got = read(server, reply + size,
+            STRESS_REPLY - 1 - size)) > 0) {
+        size += got;
+        reply[size] = '\0';
+    }
+    return expected == NULL ? size > 0 : strstr(reply, expected) != NULL;
+}
+
+/* play_lines()
+* −−−−−−−−−−−−−−−
+* Plays one game with the server, sending every line at once
+*
+* lines: lines sent
+* reply: filled with everything the server sent back
+*
+* Returns: boolean if the server replied
+*/
+bool play_lines(const char* lines, char reply[STRESS_REPLY]) {
+    int server = connect_server(lines);
+    if (server == -1) {
+        return false;
+    }
+    shutdown(server, SHUT_WR);
+    bool replied = read_reply(server, reply, NULL);
+    close(server);
+    return replied;
+}
+
+/* play_game()
+* −−−−−−−−−−−−−−−
+* Plays one game with the server
+*
+* Returns: boolean if the game was won
+*/
+bool play_game(void) {
+    char reply[STRESS_REPLY];
+    return play_lines(STRESS_GAME, reply) && strstr(reply, STRESS_WON)
+            != NULL;
+}
+
+/* versioned_known()
+* −−−−−−−−−−−−−−−
+* Checks if a new game accepts STRESS_VERSIONED as its first move
+*
+* Returns: boolean if the move was accepted
+*/
+bool versioned_known(void) {
+    char reply[STRESS_REPLY];
+    return play_lines(STRESS_OPTIONS STRESS_VERSIONED "\n", reply)
+            && strstr(reply, STRESS_MOVED) != NULL;
+}
+
+/* reload_until()
+* −−−−−−−−−−−−−−−
+* Rewrites the dictionary, has the server reload it and waits until new
+* games see the new version
+*
+* path: dictionary file location
+* filler: if STRESS_VERSIONED and filler words are in the new version
+*
+* Returns: boolean if new games saw the new version in time
+*/
+bool reload_until(const char* path, bool filler) {
+    if (write_dictionary(path, filler) == false) {
+        return false;
+    }
+    kill(serverPid, SIGHUP);
+    for (int wait = 0; wait < STRESS_WAITS; wait++) {
+        if (versioned_known() == filler) {
+            return true;
+        }
+        usleep(STRESS_WAIT_US);
+    }
+    return false;
+}
+
+/* check_versions()
+* −−−−−−−−−−−−−−−
+* Adds STRESS_VERSIONED to the dictionary and takes it away again, with a
+* game started while it was there and finished after it was gone
+*
+* path: dictionary file location
+*
+* Returns: boolean if new games accepted the word once it was added and
+* the older game still accepted it once it was taken away
+*/
+bool check_versions(const char* path) {
+    if (reload_until(path, false) == false
+            || reload_until(path, true) == false) {
+        return false;
+    }
+    char reply[STRESS_REPLY];
+    int server = connect_server(STRESS_OPTIONS);
+    //the game has its snapshot once it asks for the first word
+    if (server == -1 || read_reply(server, reply, STRESS_STARTED) == false
+            || reload_until(path, false) == false) {
+        if (server != -1) {
+            close(server);
+        }
+        return false;
+    }
+    const char* moves = STRESS_VERSIONED "\nward\n";
+    bool sent = write(server, moves, strlen(moves)) != -1;
+    shutdown(server, SHUT_WR);
+    bool won = sent && read_reply(server, reply, NULL)
+            && strstr(reply, NOT_IN_DICT) == NULL
+            && strstr(reply, STRESS_WON) != NULL;
+    close(server);
+    return won;
+}
+
+/* client_worker()
+* −−−−−−−−−−−−−−−
+* Plays games with the server one after another until every reload has
+* been sent
+*
+* arg: unused
+*
+* Returns: NULL
+*/
+void* client_worker(void* arg) {
+    while (__atomic_load_n(&reloads, __ATOMIC_RELAXED) < STRESS_RELOADS) {
+        if (play_game() == false) {
+            __atomic_add_fetch(&lost, 1, __ATOMIC_RELAXED);
+        }
+        __atomic_add_fetch(&played, 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+/* rewrite_worker()
+* −−−−−−−−−−−−−−−
+* Rewrites the dictionary in place, alternately with and without its
+* filler, and has the server reload it STRESS_RELOADS times
+*
+* arg: dictionary file location
+*
+* Returns: NULL
+*/
+void* rewrite_worker(void* arg) {
+    const char* path = arg;
+    for (int reload = 1; reload <= STRESS_RELOADS; reload++) {
+        write_dictionary(path, reload % 2 == 0);
+        kill(serverPid, SIGHUP);
+        __atomic_add_fetch(&reloads, 1, __ATOMIC_RELAXED);
+        usleep(STRESS_RELOAD_US);
+    }
+    return NULL;
+}
+
+int main(void) {
+    setenv(CACHE_ENV, STRESS_CACHE, 1);
+    char path[] = STRESS_DICT;
+    int file = mkstemp(path);
+    if (file == -1 || write_dictionary(path, true) == false) {
+        fprintf(stderr, "reload_stress: can't write %s\n", path);
+        return 1;
+    }
+    close(file);
+    char* socketPath = serverAddress.sun_path;
+    serverAddress.sun_family = AF_UNIX;
+    snprintf(socketPath, sizeof(serverAddress.sun_path), STRESS_SOCKET, path);
+    serverPid = fork();
+    if (serverPid == 0) {
+        char* argv[] = {"uqwordladder", "--server", socketPath, "--dict",
+                path, NULL};
+        uqwordladder_main(sizeof(argv) / sizeof(argv[0]) - 1, argv);
+    }
+    for (int wait = 0; wait < STRESS_WAITS && access(socketPath, F_OK) == -1;
+            wait++) {
+        usleep(STRESS_WAIT_US);
+    }
+    pthread_t reloader;
+    pthread_t clients[STRESS_CLIENTS];
+    pthread_create(&reloader, NULL, rewrite_worker, path);
+    for (int i = 0; i < STRESS_CLIENTS; i++) {
+        pthread_create(&clients[i], NULL, client_worker, NULL);
+    }
+    pthread_join(reloader, NULL);
+    for (int i = 0; i < STRESS_CLIENTS; i++) {
+        pthread_join(clients[i], NULL);
+    }
+    //a server killed by a reload (e.g. SIGBUS) has already exited
+    bool running = waitpid(serverPid, NULL, WNOHANG) == 0;
+    bool versions = running == true && check_versions(path);
+    if (running == true) {
+        kill(serverPid, SIGTERM);
+        waitpid(serverPid, NULL, 0);
+    }
+    unlink(path);
+    unlink(socketPath);
+    bool passed = running == true && lost == 0 && versions == true;
+    fprintf(stdout, "reload_stress: %d of %d games lost over %d reloads, "
+            "server %s, versions %s, %s\n", lost, played, reloads,
+            running ? "running" : "dead", versions ? "kept" : "mixed up",
+            passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -5,14 +5,30 @@
  * Student number: 47435568
  */
 
+//fopencookie() lets a session's game print straight into its reply buffer
+#define _GNU_SOURCE
+
 // includes
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <unistd.h>
-#include <csse2310a1.h>
+#include <limits.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <signal.h>
+#include <errno.h>
+#include <pthread.h>
+#include <malloc.h>
 
 // constants
 #define MAX_LENGTH 9
@@ -21,7 +37,19 @@
 #define MAX_STEP 40
 #define DEF_STEP 13
 #define GAVE_UP_CODE 19
-#define MAX_WORD 50
+#define READ_CHUNK 65536
+#define PACK_WORDS 1024
+#define PACK_CHUNK (1 << 22)
+#define ARENA_BLOCK (1 << 16)
+#define ARENA_ALIGN 16
+#define CACHE_MAGIC 0x4c575155u
+#define CACHE_VERSION 3
+#define CACHE_ALIGN 8
+#define CACHE_ENV "UQWORDLADDER_CACHE"
+#define CACHE_XDG_ENV "XDG_CACHE_HOME"
+#define CACHE_HOME "%s/.cache"
+#define CACHE_NAME "%s/uqwordladder-%08x-%u.cache"
+#define CACHE_TEMP "%s.%d.tmp"
 #define STEP_ERROR_CODE 13
 #define FILE_ERROR_CODE 1
 #define WORD_LEN_ERROR_CODE 15
@@ -29,6 +57,35 @@
 #define USAGE_ERROR_CODE 11
 #define WORD_ERROR_CODE 10
 #define WORD_SAME_CODE 4
+#define NO_LADDER_CODE 3
+#define NO_PUZZLE_CODE 5
+#define SERVER_ERROR_CODE 6
+#define GAME_LOST_CODE 12
+#define GAME_PLAYING -1
+#define MAX_EVENTS 64
+#define MAX_LINE 1024
+#define LISTEN_BACKLOG 128
+#define OUTPUT_BUFFER 65536
+#define SESSION_OUTPUT 4096
+#define FREE_SESSIONS 64
+#define SPARE_FILE "/dev/null"
+#define ANALYZE_CHUNK 64
+#define STATS_ENV "UQWORDLADDER_STATS"
+#define STATS_BUCKETS 40
+#define HASH_SEED 2166136261u
+#define HASH_PRIME 16777619u
+#define CODE_HASH 0x9e3779b97f4a7c15ull
+#define LETTER_BITS 5
+#define LETTER_MASK 31u
+#define EMPTY_SLOT -1
+#define UNREACHED UCHAR_MAX
+#define ALPHABET 26
+#define ANY_LENGTH 0
+//substitutions, deletions and insertions of one word
+#define MAX_NEIGHBOURS (MAX_LENGTH * (ALPHABET - 1) + MAX_LENGTH\
+        + MAX_LENGTH * ALPHABET)
+//random walks tried before a puzzle is given up on
+#define MAX_WALKS 100
 #define DEF_DICT "/usr/share/dict/words"
 #define LENGTH_CONFLICT "uqwordladder: Word length conflict - lengths must be\
  consistent"
@@ -50,6 +107,83 @@ Your goal is to turn '%s' into '%s' in at most %d steps\n"
 #define NO_PREVIOUS "You can't return to a previous word - try again."
 #define NOT_IN_DICT "Word not found in dictionary - try again."
 #define GAME_OVER "Game over - no more steps remaining."
+#define NO_FINISH "The target can no longer be reached within the step limit."
+#define SUGGEST_HEAD "Suggestions:-----------\n"
+#define SUGGEST_TAIL "-----End of Suggestions\n"
+#define NO_SUGGESTIONS "No suggestions available.\n"
+#define SOLUTION "Shortest ladder from '%s' to '%s' takes %d steps:\n"
+#define NO_PUZZLE "uqwordladder: No solvable ladder can be made from the\
+ dictionary"
+#define SERVER_ERROR "uqwordladder: Unable to listen on \"%s\"\n"
+#define NO_SOLUTION "No ladder from '%s' to '%s' within %d steps.\n"
+#define LADDER_COUNT "%s%llu shortest ladders from '%s' to '%s' take %d steps\n"
+#define BATCH_RESULT "%d\t%s\t%d\t%s\t%s\n"
+#define ANALYZE_SUMMARY "Length %u: %d words, %d one letter links\n"
+#define ANALYZE_DIAMETER "Diameter: %d steps from '%s' to '%s'\n"
+#define BATCH_SUMMARY "uqwordladder: %d games in %.3f seconds (%.0f games/s)\n"
+#define RELOAD_ASKED 'h'
+#define RELOAD_DONE 'l'
+#define EMBED_SOURCE "uqWordLadderDict.c"
+#define EMBED_PER_LINE 6
+#define EMBED_HEADER "/*Default dictionary compiled in with -DEMBED_DICT, made\
+ by uqwordladder --embed\nfrom %s. Do not edit.*/\n"
+
+#ifdef EMBED_DICT
+//per-length word codes and neighbour graphs made by --embed
+#include EMBED_SOURCE
+#endif
+
+/*Block of memory handed out by an arena, its bytes follow the header*/
+typedef struct ArenaBlock {
+    struct ArenaBlock* next; //block used once this one is full
+    size_t size; //number of bytes in the block after the header
+} ArenaBlock;
+
+/*Bump allocator. Everything it hands out is released together, and it can
+be reset to hand out the same blocks again without touching the heap.*/
+typedef struct {
+    ArenaBlock* first; //first block, NULL until something is allocated
+    ArenaBlock* current; //block allocations are being made from
+    size_t used; //bytes of current already handed out
+} Arena;
+
+/*Dictionary of one word length, or of every length for games whose steps
+may change the length. It is read only once loaded, so any number of games
+can share it.*/
+typedef struct {
+    unsigned int wordLen; //length of every word, or ANY_LENGTH
+    int wordsInDict; //number of words in dictionary
+    uint64_t* codes; //words packed LETTER_BITS a letter, sorted and unique
+    int* index; //open addressing hash of code indexes, EMPTY_SLOT if free
+    uint64_t* indexCodes; //code of each index slot, 0 if free
+    int* neighStart; //CSR offsets into neighbours, wordsInDict + 1 long
+    int* neighbours; //indexes of words one letter away from each word
+    int* starts; //words with a neighbour, which random puzzles start from
+    int startCount; //number of words in starts
+    void* cache; //mapped dictionary cache the dictionary arrays point into
+    size_t cacheSize; //number of bytes mapped for the cache
+    Arena arena; //memory of every array the dictionary owns
+} Dict;
+
+/*State of one game. Its words are stored in place and its tables come from
+its own arena, so playing a game allocates nothing.*/
+typedef struct {
+    const Dict* dict; //shared dictionary of the game's word length
+    char initWord[MAX_LENGTH + 1]; //initial word, empty until picked
+    char toWord[MAX_LENGTH + 1]; //target word, empty until picked
+    unsigned int stepLim; //step limit
+    int attempt; //number of attempts user has made
+    char givenWords[MAX_STEP][MAX_LENGTH + 1]; //words given by user
+    unsigned char* visited; //bitset of the dictionary words given by user
+    unsigned char* distance; //steps from each word to the target or UNREACHED
+    bool stranded; //if the user has been told the target is out of reach
+    char suggestedFor[MAX_LENGTH + 1]; //word suggestions are for, or empty
+    char* suggestions; //suggestion lines for suggestedFor, ready to write
+    size_t suggestionsSize; //number of bytes in suggestions
+    Arena arena; //memory of the game's tables, reset for each new game
+    FILE* out; //where game messages are printed
+    int result; //exit code once the game is over, GAME_PLAYING until then
+} Game;
 
 /*Infomation need for the game*/
 typedef struct {
@@ -63,16 +197,345 @@ typedef struct {
     bool stepLimSet; //if step limit is set
     bool initWordSet; //if initial word is set
     bool toWordSet; //if target word is set
-    int wordsInDict; //number of words in dictionary
-    char** filteredDict; //stored array of words from dictionary
-    char** givenWords; //stored array of words given by user
-    int attempt; //number of attempts user has made
-    int sugWordsLen; //number of words user can make
-    char** sugWords; //array of suggested words user can make
+    bool solve; //if the shortest ladder is printed instead of playing
+    bool count; //if the shortest ladders are counted instead of playing
+    unsigned int ladders; //number of shortest ladders printed when counting
+    bool analyze; //if ladder statistics are printed instead of playing
+    bool embed; //if the dictionary is written as C source instead of playing
+    bool edit; //if steps may also insert or delete a letter
+    char* server; //socket to serve games on, NULL to play on stdin
+    char* batch; //file of games to replay, NULL to play on stdin
+    Dict dicts[MAX_LENGTH + 1]; //dictionary of each length, ANY_LENGTH too
+    pthread_t loader; //thread loading the dictionary in the background
+    bool loading; //if the loader is still to be joined
+    bool loaded; //if the loader could read the dictionary file
+    Game game; //game played on stdin, dict is NULL until it starts
 } Data;
 
+/*Start of a dictionary cache file, followed by the dictionary path, the
+word codes and the neighbour graph*/
+typedef struct {
+    unsigned int magic; //CACHE_MAGIC
+    unsigned int version; //CACHE_VERSION
+    unsigned int wordLen; //length of every word in the cache
+    unsigned int pathLen; //length of the dictionary path after the header
+    long long dictSize; //size of the dictionary file when cached
+    long long mtimeSec; //modification time of the dictionary file
+    long long mtimeNsec; //nanoseconds part of the modification time
+    long long inode; //inode of the dictionary file
+    int wordsInDict; //number of words in the cache
+    int edges; //number of entries in the neighbour array
+} CacheHeader;
+
+/*Dictionary of every word length loaded together by the server. It is
+never changed once published, and games keep the snapshot they started on,
+so a reload never changes the words under a game in progress.*/
+typedef struct {
+    Dict dicts[MAX_LENGTH + 1]; //dictionary of each word length
+    int games; //number of games started on it still being played
+    bool retired; //if a newer snapshot has replaced it
+} Snapshot;
+
+/*Dictionary reloading of the server, shared with its loader thread and
+SIGHUP handler, which both wake the server through the pipe*/
+typedef struct {
+    Snapshot* current; //snapshot new games start on, swapped atomically
+    Snapshot* replaced; //snapshot the last load replaced, NULL if it failed
+    const Data* data; //options the dictionary is loaded with
+    int pipe[2]; //RELOAD_ASKED and RELOAD_DONE bytes for the server
+    bool loading; //if a loader thread is running
+    bool again; //if a reload was asked for while loading
+} Reload;
+
+/*One game played over a server connection. Closed sessions are kept on a
+free list with their arena, reply buffer and stream, so the next player
+reuses them instead of the heap.*/
+typedef struct Session {
+    int fd; //connection to the player
+    bool started; //if the game options line has been read
+    bool closing; //if the connection closes once output is sent
+    Snapshot* snapshot; //dictionaries the game started on, NULL until then
+    Game game; //state of this game
+    char input[MAX_LINE]; //bytes read but not yet handled
+    size_t inputLen; //number of bytes in input
+    char* output; //bytes waiting to be sent to the player
+    size_t outputLen; //number of bytes in output
+    size_t outputSize; //number of bytes allocated for output
+    size_t outputSent; //number of bytes of output already sent
+    FILE* out; //stream the game prints to, appending to output
+    struct Session* next; //next session on the free list
+} Session;
+
+/*Latency histogram of one instrumented operation. Bucket b counts the
+times taken of 2^b to 2^(b + 1) nanoseconds.*/
+typedef struct {
+    long long count; //number of times the operation was timed
+    long long totalNs; //total nanoseconds taken
+    long long maxNs; //longest time taken
+    long long buckets[STATS_BUCKETS]; //number of times in each range
+} Timing;
+
+/*Counters kept when --stats or $UQWORDLADDER_STATS is given, printed to
+stderr on exit*/
+typedef struct {
+    bool enabled; //if the counters are kept at all
+    long long startNs; //time main() started
+    long long promptNs; //nanoseconds from start to the first word prompt
+    long long waitNs; //nanoseconds waiting for a background dictionary load
+    long long loadNs; //nanoseconds spent loading dictionaries
+    long long linesScanned; //dictionary lines looked at while packing
+    long long wordsAccepted; //dictionary words packed
+    Timing moves; //checking each line entered other than "?"
+    Timing suggestions; //working out and printing suggestions
+    long long candidates; //neighbours considered for suggestions
+    long long suggested; //suggestions printed
+    long long suggestionHits; //"?" answered from the game's last suggestions
+    long long heapAllocs; //malloc, calloc and realloc calls made directly
+    long long arenaAllocs; //pieces of memory handed out by arenas
+} Stats;
+
+Stats stats;
+
+Reload reload;
+
+//closed sessions kept for reuse, and how many there are
+Session* freeSessions;
+int freeSessionCount;
+
 // functions
 
+/* stats_malloc()
+* −−−−−−−−−−−−−−−
+* malloc() that counts the allocation when stats are kept. Every heap
+* allocation the program asks for itself goes through these. Those the C
+* library makes for it, for stdio streams and their buffers and inside
+* getline(), aren't counted, though they are in the heap bytes in use.
+*
+* size: number of bytes wanted
+*
+* Returns: pointer to the memory
+*/
+void* stats_malloc(size_t size) {
+    if (stats.enabled == true) {
+        __atomic_add_fetch(&stats.heapAllocs, 1, __ATOMIC_RELAXED);
+    }
+    return malloc(size);
+}
+
+/* stats_calloc()
+* −−−−−−−−−−−−−−−
+* calloc() that counts the allocation when stats are kept
+*
+* count: number of elements wanted
+* size: number of bytes in each element
+*
+* Returns: pointer to the zeroed memory
+*/
+void* stats_calloc(size_t count, size_t size) {
+    if (stats.enabled == true) {
+        __atomic_add_fetch(&stats.heapAllocs, 1, __ATOMIC_RELAXED);
+    }
+    return calloc(count, size);
+}
+
+/* stats_realloc()
+* −−−−−−−−−−−−−−−
+* realloc() that counts the allocation when stats are kept
+*
+* memory: memory to resize, or NULL
+* size: number of bytes wanted
+*
+* Returns: pointer to the resized memory
+*/
+void* stats_realloc(void* memory, size_t size) {
+    if (stats.enabled == true) {
+        __atomic_add_fetch(&stats.heapAllocs, 1, __ATOMIC_RELAXED);
+    }
+    return realloc(memory, size);
+}
+
+/* arena_alloc()
+* −−−−−−−−−−−−−−−
+* Hands out memory from an arena, moving on to the next block (or a new
+* one) when the current block is full
+*
+* arena: arena to allocate from
+* size: number of bytes wanted
+*
+* Returns: pointer to the memory, aligned for any type
+*/
+void* arena_alloc(Arena* arena, size_t size) {
+    if (stats.enabled == true) {
+        __atomic_add_fetch(&stats.arenaAllocs, 1, __ATOMIC_RELAXED);
+    }
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (arena->current == NULL || arena->used + size > arena->current->size) {
+        ArenaBlock* next = arena->current == NULL ? arena->first
+                : arena->current->next;
+        if (next == NULL || next->size < size) {
+            //new blocks go after the current one so reuse stays in order
+            size_t blockSize = size > ARENA_BLOCK ? size : ARENA_BLOCK;
+            ArenaBlock* block = stats_malloc(ARENA_ALIGN + blockSize);
+            block->size = blockSize;
+            block->next = next;
+            if (arena->current == NULL) {
+                arena->first = block;
+            } else {
+                arena->current->next = block;
+            }
+            next = block;
+        }
+        arena->current = next;
+        arena->used = 0;
+    }
+    void* memory = (char*)arena->current + ARENA_ALIGN + arena->used;
+    arena->used += size;
+    return memory;
+}
+
+/* arena_reset()
+* −−−−−−−−−−−−−−−
+* Takes back everything handed out by an arena so its blocks are used
+* again, without freeing them
+*
+* arena: arena to reset
+*
+* Returns: Nothing
+*/
+void arena_reset(Arena* arena) {
+    arena->current = NULL;
+    arena->used = 0;
+}
+
+/* arena_free()
+* −−−−−−−−−−−−−−−
+* Frees every block of an arena
+*
+* arena: arena to free
+*
+* Returns: Nothing
+*/
+void arena_free(Arena* arena) {
+    ArenaBlock* block = arena->first;
+    while (block != NULL) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    memset(arena, 0, sizeof(Arena));
+}
+
+/* free_dict()
+* −−−−−−−−−−−−−−−
+* Frees the memory belonging to a dictionary
+*
+* dict: dictionary of one word length
+*
+* Returns: Nothing.
+*/
+void free_dict(Dict* dict) {
+    //a mapped cache holds the dictionary arrays itself
+    if (dict->cache != NULL) {
+        munmap(dict->cache, dict->cacheSize);
+    }
+    arena_free(&dict->arena);
+    memset(dict, 0, sizeof(Dict));
+}
+
+/* game_free()
+* −−−−−−−−−−−−−−−
+* Frees the memory belonging to a game, not its shared dictionary
+*
+* game: game to free
+*
+* Returns: Nothing
+*/
+void game_free(Game* game) {
+    arena_free(&game->arena);
+    game->visited = NULL;
+    game->distance = NULL;
+}
+
+/* stats_now()
+* −−−−−−−−−−−−−−−
+* Reads the monotonic clock for timing operations
+*
+* Returns: nanoseconds since an arbitrary start
+*/
+long long stats_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/* stats_record()
+* −−−−−−−−−−−−−−−
+* Adds the time taken since start to a histogram
+*
+* timing: histogram of the operation
+* start: stats_now() when the operation began
+*
+* Returns: Nothing
+*/
+void stats_record(Timing* timing, long long start) {
+    long long taken = stats_now() - start;
+    int bucket = 0;
+    while (bucket < STATS_BUCKETS - 1 && (2LL << bucket) <= taken) {
+        bucket++;
+    }
+    timing->buckets[bucket]++;
+    timing->count++;
+    timing->totalNs += taken;
+    if (taken > timing->maxNs) {
+        timing->maxNs = taken;
+    }
+}
+
+/* stats_print()
+* −−−−−−−−−−−−−−−
+* Prints the summary and non-empty buckets of a histogram to stderr
+*
+* name: name of the operation
+* timing: histogram of the operation
+*
+* Returns: Nothing
+*/
+void stats_print(const char* name, const Timing* timing) {
+    fprintf(stderr, "%s: %lld timed, mean %lld ns, max %lld ns\n", name,
+            timing->count, timing->count ? timing->totalNs / timing->count
+            : 0, timing->maxNs);
+    for (int b = 0; b < STATS_BUCKETS; b++) {
+        if (timing->buckets[b] > 0) {
+            fprintf(stderr, "  %lld-%lld ns\t%lld\n", b ? 1LL << b : 0,
+                    (2LL << b) - 1, timing->buckets[b]);
+        }
+    }
+}
+
+/* stats_dump()
+* −−−−−−−−−−−−−−−
+* Prints every counter to stderr
+*
+* Returns: Nothing
+*/
+void stats_dump(void) {
+    struct mallinfo2 heap = mallinfo2();
+    fprintf(stderr, "uqwordladder stats:\n");
+    fprintf(stderr, "dictionary load: %.3f ms, %lld lines scanned, %lld words"
+            " accepted\n", stats.loadNs / 1e6, stats.linesScanned,
+            stats.wordsAccepted);
+    fprintf(stderr, "first prompt: %.3f ms after start, %.3f ms waiting for"
+            " the dictionary\n", stats.promptNs / 1e6, stats.waitNs / 1e6);
+    fprintf(stderr, "heap: %zu bytes in use, %zu bytes mapped, %lld "
+            "allocations\n", heap.uordblks, heap.hblkhd, stats.heapAllocs);
+    fprintf(stderr, "arenas: %lld allocations\n", stats.arenaAllocs);
+    stats_print("moves", &stats.moves);
+    stats_print("suggestions", &stats.suggestions);
+    fprintf(stderr, "suggestion candidates: %lld, suggested: %lld, "
+            "reused: %lld\n", stats.candidates, stats.suggested,
+            stats.suggestionHits);
+}
+
 /* my_exit()
 * −−−−−−−−−−−−−−−
 * Frees all memory, that was allocated memory, and exits the program.
@@ -82,29 +545,21 @@ typedef struct {
 *
 * Returns: Nothing.
 */
-void my_exit(int exitCode, Data data){
-    free(data.initWord);
-    free(data.toWord);
-    //freeing all memory to avoid memory leaks
-    if (data.wordsInDict > 0) {
-        for (int i = 0; i < data.wordsInDict; i++) {
-            free(data.filteredDict[i]);
-        }
+void my_exit(int exitCode, Data* data){
+    //a background load is finished before anything it fills is used
+    if (data->loading == true) {
+        pthread_join(data->loader, NULL);
+        data->loading = false;
     }
-    if (data.attempt > 1) {
-        for (int i = 0; i < data.attempt - 1; i++) {
-            free(data.givenWords[i]);
-        }
+    //stats are printed while the memory they describe is still in use
+    if (stats.enabled == true) {
+        stats_dump();
     }
-    if (data.sugWordsLen > 0) { 
-        for (int i = 0; i < data.sugWordsLen; i++) {
-            free(data.sugWords[i]);
-        }
-        
+    //freeing all memory to avoid memory leaks
+    game_free(&data->game);
+    for (int length = ANY_LENGTH; length <= MAX_LENGTH; length++) {
+        free_dict(&data->dicts[length]);
     }
-    free(data.sugWords);
-    free(data.filteredDict);
-    free(data.givenWords);
     exit(exitCode);
 }
 
@@ -118,7 +573,7 @@ void my_exit(int exitCode, Data data){
 *
 * Returns: Nothing.
 */
-void error_exit(char* message, int exitCode, Data data) {
+void error_exit(char* message, int exitCode, Data* data) {
     fprintf(stderr, "%s\n", message);
     my_exit(exitCode, data);
 }
@@ -181,18 +636,18 @@ void make_caps(char* word) {
 * argc: number of arguments given
 * argv[]: arguments given
 *
-* Returns: Updated data
+* Returns: Nothing
 * Errors: Error message prints and exits if invalid length given
 */
-Data check_input_length(Data data, int argc, char* argv[]) {
+void check_input_length(Data* data, int argc, char* argv[]) {
     for (int i = 1; i < argc; i++) {
         //compares to see is --length is a given argument
         if (strcmp(argv[i], "--length") == 0) {
             // (i + 1 < argc) checks if next arg exists
-            if (i + 1 < argc && data.wordLenSet == false 
+            if (i + 1 < argc && data->wordLenSet == false 
                     && atol(argv[i + 1]) > 0 && check_digits(argv[i + 1])) {
-                data.wordLen = atol(argv[i + 1]);
-                data.wordLenSet = true;
+                data->wordLen = atol(argv[i + 1]);
+                data->wordLenSet = true;
                 i++;
             } else {
                 fprintf(stderr, "%s\n", USAGE_ERROR);
@@ -200,32 +655,25 @@ Data check_input_length(Data data, int argc, char* argv[]) {
             }
         }
     }
-    if (data.wordLenSet == false) {
-        data.wordLen = DEF_LENGTH;
+    if (data->wordLenSet == false) {
+        data->wordLen = DEF_LENGTH;
     }
-    return data;
 }
 
 /* malloc_set()
 * −−−−−−−−−−−−−−−
 * −−−−−−−−−−−−−−−
-* Allocates memory and sets variables
+* Empties the dictionaries and game, so they can be freed at any time
 *
 * data: Struct containing all the data for the game.
 *
-* Returns: Updated data
+* Returns: Nothing
 */
-Data malloc_set(Data data){
-    //Cast incase of warning
-    data.givenWords = (char** )malloc(sizeof(char*)); 
-    data.filteredDict = (char** )malloc(sizeof(char*));
-    data.wordsInDict = 0;
-    data.attempt = 1;
-    data.sugWords = (char** )malloc(sizeof(char*));
-    data.sugWordsLen = 0;
-    data.initWord = (char* )malloc(sizeof(char) * (data.wordLen + 1));
-    data.toWord = (char* )malloc(sizeof(char) * (data.wordLen + 1));
-    return data;
+void malloc_set(Data* data){
+    memset(data->dicts, 0, sizeof(data->dicts));
+    memset(&data->game, 0, sizeof(Game));
+    data->initWord = NULL;
+    data->toWord = NULL;
 }
 
 /* check_command_line()
@@ -236,45 +684,66 @@ Data malloc_set(Data data){
 * argc: number of arguments given
 * argv[]: arguments given
 *
-* Returns: Updated data
+* Returns: Nothing
 * Errors: Error message prints and exits if invalid commands given
 */
-Data check_command_line(Data data, int argc, char* argv[]) {
-    data = check_input_length(data, argc, argv);
-    //mallocs memory now so easy to free later
-    data = malloc_set(data);
+void check_command_line(Data* data, int argc, char* argv[]) {
+    check_input_length(data, argc, argv);
+    //empties everything now so easy to free later
+    malloc_set(data);
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--init") == 0 && i + 1 < argc 
-                && data.initWordSet == false) {
-            if (strlen(argv[i + 1]) != data.wordLen) {
-                data.initWord = realloc(data.initWord,
-                        sizeof(char) * (strlen(argv[i + 1]) + 1));
-            }
-            strcpy(data.initWord, argv[i + 1]);
-            make_caps(data.initWord);
-            data.initWordSet = true;
+                && data->initWordSet == false) {
+            //the word is used in place, it is copied into the game later
+            data->initWord = argv[i + 1];
+            make_caps(data->initWord);
+            data->initWordSet = true;
             i++;
         } else if (strcmp(argv[i], "--target") == 0 && i + 1 < argc 
-                && data.toWordSet == false) {
-            if (strlen(argv[i + 1]) != data.wordLen) {
-                data.toWord = realloc(data.toWord, 
-                        sizeof(char) * (strlen(argv[i + 1]) + 1));
-            }
-            strcpy(data.toWord, argv[i + 1]);
+                && data->toWordSet == false) {
+            data->toWord = argv[i + 1];
             //makes all letters uppercase
-            make_caps(data.toWord);
-            data.toWordSet = true;
+            make_caps(data->toWord);
+            data->toWordSet = true;
             i++;
         } else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc 
-                && data.stepLimSet == false && atol(argv[i + 1]) > 0 
+                && data->stepLimSet == false && atol(argv[i + 1]) > 0 
                 && check_digits(argv[i + 1])) {
-            data.stepLim = atol(argv[i + 1]);
-            data.stepLimSet = true;
+            data->stepLim = atol(argv[i + 1]);
+            data->stepLimSet = true;
             i++;
         } else if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc 
-                && data.dictSet == false) {
-            data.dict = argv[i + 1];
-            data.dictSet = true;
+                && data->dictSet == false) {
+            data->dict = argv[i + 1];
+            data->dictSet = true;
+            i++;
+        } else if (strcmp(argv[i], "--solve") == 0 && data->solve == false) {
+            data->solve = true;
+        } else if (strcmp(argv[i], "--count") == 0 && data->count == false) {
+            data->count = true;
+        } else if (strcmp(argv[i], "--ladders") == 0 && i + 1 < argc
+                && data->ladders == 0 && atol(argv[i + 1]) > 0
+                && check_digits(argv[i + 1])) {
+            //printing ladders means counting them too
+            data->ladders = atol(argv[i + 1]);
+            data->count = true;
+            i++;
+        } else if (strcmp(argv[i], "--analyze") == 0
+                && data->analyze == false) {
+            data->analyze = true;
+        } else if (strcmp(argv[i], "--embed") == 0 && data->embed == false) {
+            data->embed = true;
+        } else if (strcmp(argv[i], "--edit") == 0 && data->edit == false) {
+            data->edit = true;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            stats.enabled = true;
+        } else if (strcmp(argv[i], "--server") == 0 && i + 1 < argc
+                && data->server == NULL) {
+            data->server = argv[i + 1];
+            i++;
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc
+                && data->batch == NULL) {
+            data->batch = argv[i + 1];
             i++;
         } else if (strcmp(argv[i], "--length") == 0) {
             //Do nothing it was checked before
@@ -283,7 +752,37 @@ Data check_command_line(Data data, int argc, char* argv[]) {
             error_exit(USAGE_ERROR, USAGE_ERROR_CODE, data);
         }
     }
-    return data;
+    //--solve prints one ladder and --count every ladder, so only one is run
+    if (data->solve == true && data->count == true) {
+        error_exit(USAGE_ERROR, USAGE_ERROR_CODE, data);
+    }
+}
+
+/* edit_length_check()
+* −−−−−−−−−−−−−−−
+* Sets word length if not given for --edit, where steps may change the
+* length. The word length is then the initial word's length, and the target
+* only has to be in the valid range.
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if legnths are inconsistent or not in
+* valid range
+*/
+void edit_length_check(Data* data) {
+    if (data->wordLenSet == false && data->initWordSet == true) {
+        data->wordLen = strlen(data->initWord);
+    }
+    if (data->initWordSet == true
+            && strlen(data->initWord) != data->wordLen) {
+        error_exit(LENGTH_CONFLICT, LENGTH_CONFLICT_CODE, data);
+    }
+    if (data->wordLen < MIN_LENGTH || data->wordLen > MAX_LENGTH
+            || (data->toWordSet == true && (strlen(data->toWord) < MIN_LENGTH
+            || strlen(data->toWord) > MAX_LENGTH))) {
+        error_exit(WORD_LEN_ERROR, WORD_LEN_ERROR_CODE, data);
+    }
 }
 
 /* length_check()
@@ -293,38 +792,41 @@ Data check_command_line(Data data, int argc, char* argv[]) {
 *
 * data: Struct containing all the data for the game.
 *
-* Returns: Updated data
+* Returns: Nothing
 * Errors: Error message prints and exits if legnths are inconsistent or not in 
 * valid range
 */
-Data length_check(Data data) {
+void length_check(Data* data) {
+    if (data->edit == true) {
+        edit_length_check(data);
+        return;
+    }
     //sets lenght of the word if not specified
-    if (data.wordLenSet == false && data.initWordSet == false 
-            && data.toWordSet == true) {
-        data.wordLen = strlen(data.toWord);
-    } else if (data.wordLenSet == false && data.initWordSet == true 
-            && data.toWordSet == false) {
-        data.wordLen = strlen(data.initWord);
+    if (data->wordLenSet == false && data->initWordSet == false 
+            && data->toWordSet == true) {
+        data->wordLen = strlen(data->toWord);
+    } else if (data->wordLenSet == false && data->initWordSet == true 
+            && data->toWordSet == false) {
+        data->wordLen = strlen(data->initWord);
     }
     //checks if the length of the words are the same
-    if (data.initWordSet == true){
-        if (strlen(data.initWord) != data.wordLen) {
+    if (data->initWordSet == true){
+        if (strlen(data->initWord) != data->wordLen) {
             error_exit(LENGTH_CONFLICT, LENGTH_CONFLICT_CODE, data);
-        } else if (data.toWordSet == true && strlen(data.toWord) 
-                != strlen(data.initWord)) {
+        } else if (data->toWordSet == true && strlen(data->toWord) 
+                != strlen(data->initWord)) {
             error_exit(LENGTH_CONFLICT, LENGTH_CONFLICT_CODE, data);
         }
     } 
-    if (data.toWordSet == true) {
-        if (strlen(data.toWord) != data.wordLen) {
+    if (data->toWordSet == true) {
+        if (strlen(data->toWord) != data->wordLen) {
             error_exit(LENGTH_CONFLICT, LENGTH_CONFLICT_CODE, data);
         }
     } 
     //checks if the word length is in valid range
-    if (data.wordLen < MIN_LENGTH || data.wordLen > MAX_LENGTH) {
+    if (data->wordLen < MIN_LENGTH || data->wordLen > MAX_LENGTH) {
         error_exit(WORD_LEN_ERROR, WORD_LEN_ERROR_CODE, data);
     }
-    return data;
 }
 
 /* word_check()
@@ -333,31 +835,25 @@ Data length_check(Data data) {
 *
 * data: Struct containing all the data for the game.
 *
-* Returns: Updated data
+* Returns: Nothing
 * Errors: Error message prints and exits if initial and target words are same
 */
-Data word_check(Data data) {
-    if (data.initWordSet == true) {
-        if (check_chars(data.initWord) == false) {
+void word_check(Data* data) {
+    if (data->initWordSet == true) {
+        if (check_chars(data->initWord) == false) {
             error_exit(WORD_ERROR, WORD_ERROR_CODE, data);
         }
-    } else {
-        // stored in a temp variable to avoid same word being pointed to
-        const char* temp = get_uqwordladder_word(data.wordLen);
-        strcpy(data.initWord, temp);
     }
-    if (data.toWordSet == true) {
-        if (check_chars(data.toWord) == false) {
+    if (data->toWordSet == true) {
+        if (check_chars(data->toWord) == false) {
             error_exit(WORD_ERROR, WORD_ERROR_CODE, data);
         }
-    } else {
-        const char* temp2 = get_uqwordladder_word(data.wordLen);
-        strcpy(data.toWord, temp2);
     }
-    if (strcasecmp(data.initWord, data.toWord) == 0) {
+    //missing words are generated once the dictionary is read
+    if (data->initWordSet == true && data->toWordSet == true
+            && strcasecmp(data->initWord, data->toWord) == 0) {
         error_exit(WORD_SAME, WORD_SAME_CODE, data);
     }    
-    return data;
 }
 
 /* step_check()
@@ -366,16 +862,15 @@ Data word_check(Data data) {
 *
 * data: Struct containing all the data for the game.
 *
-* Returns: Updated data
+* Returns: Nothing
 * Errors: Error message prints and exits if stemp limit out of set range
 */
-Data step_check(Data data) {
-    if (data.stepLimSet == false) {
-        data.stepLim = DEF_STEP;
-    } else if (data.stepLim < data.wordLen || data.stepLim > MAX_STEP) {
+void step_check(Data* data) {
+    if (data->stepLimSet == false) {
+        data->stepLim = DEF_STEP;
+    } else if (data->stepLim < data->wordLen || data->stepLim > MAX_STEP) {
         error_exit(STEP_ERROR, STEP_ERROR_CODE, data);
     }
-    return data;
 }
 
 /* set_false()
@@ -384,259 +879,3265 @@ Data step_check(Data data) {
 *
 * data: Struct containing all the data for the game.
 *
-* Returns: Updated data
+* Returns: Nothing
 */
-Data set_false(Data data) {
-    data.dictSet = false;
-    data.wordLenSet = false;
-    data.stepLimSet = false;
-    data.initWordSet = false;
-    data.toWordSet = false;
-    return data;
+void set_false(Data* data) {
+    data->dictSet = false;
+    data->wordLenSet = false;
+    data->stepLimSet = false;
+    data->initWordSet = false;
+    data->toWordSet = false;
+    data->solve = false;
+    data->count = false;
+    data->ladders = 0;
+    data->analyze = false;
+    data->embed = false;
+    data->edit = false;
+    data->server = NULL;
+    data->batch = NULL;
+    data->loading = false;
+    data->loaded = false;
 }
 
-/* read_dictionary()
+/* hash_word()
 * −−−−−−−−−−−−−−−
-* Reads the dictionary file and stores all valid length words in an array
+* Hashes an uppercase word using FNV-1a
 *
-* data: Struct containing all the data for the game.
+* word: The given pointer to the string.
 *
-* Returns: Updated data
-* Errors: Error message prints and exits if unreadable or non-existent
+* Returns: hash of the word
 */
-Data read_dictionary(Data data) {
-    if (data.dictSet == false) {
-        data.dict = DEF_DICT;
-    }
-    FILE* file = fopen(data.dict, "r");
-    if (file == NULL){
-        fprintf(stderr, FILE_NOT_OPENING, data.dict);
-        my_exit(FILE_ERROR_CODE, data);
+unsigned int hash_word(const char* word) {
+    unsigned int hash = HASH_SEED;
+    while (*word) {
+        hash ^= (unsigned char)*word;
+        hash *= HASH_PRIME;
+        word++;
     }
-    char word[MAX_WORD + 1]; // +1 for null terminator
+    return hash;
+}
 
-    while (fgets(word, sizeof(char*) * MAX_WORD, file) != NULL) {
-        if (strlen(word) > 0 && word[strlen(word) - 1] == '\n') {
-            word[strlen(word) - 1] = '\0';
+/* word_code()
+* −−−−−−−−−−−−−−−
+* Packs an uppercase word into LETTER_BITS a letter, first letter highest.
+* Letters are 1 to 26, so codes of one length sort alphabetically and no
+* two words of any length share a code.
+*
+* word: given uppercase word to pack
+*
+* Returns: code of the word, or 0 if it isn't a word of only A to Z
+*/
+uint64_t word_code(const char* word) {
+    uint64_t code = 0;
+    for (int i = 0; word[i] != '\0'; i++) {
+        if (i == MAX_LENGTH || word[i] < 'A' || word[i] > 'Z') {
+            return 0;
         }
-        if (strlen(word) == data.wordLen && check_chars(word)) {  
-            data.filteredDict = (char**)realloc(data.filteredDict,
-                sizeof(char*) * (data.wordsInDict + 1));
-            make_caps(word);
-            data.filteredDict[data.wordsInDict] = strdup(word);
-            data.wordsInDict++;
+        code = code << LETTER_BITS | (uint64_t)(word[i] - 'A' + 1);
+    }
+    return code;
+}
+
+/* dict_word()
+* −−−−−−−−−−−−−−−
+* Unpacks a word of the dictionary
+*
+* dict: dictionary of one word length
+* index: index of the word in the dictionary
+* word: filled with the null terminated word
+*
+* Returns: word
+*/
+char* dict_word(const Dict* dict, int index, char word[MAX_LENGTH + 1]) {
+    uint64_t code = dict->codes[index];
+    int length = dict->wordLen;
+    if (length == ANY_LENGTH) {
+        //no letter is 0, so the length is the number of letters left
+        for (uint64_t rest = code; rest != 0; rest >>= LETTER_BITS) {
+            length++;
         }
     }
-    //closes file
-    fclose(file);
-    return data;
+    for (int i = length - 1; i >= 0; i--) {
+        word[i] = 'A' - 1 + (code & LETTER_MASK);
+        code >>= LETTER_BITS;
+    }
+    word[length] = '\0';
+    return word;
 }
 
-/* print_stdout()
+/* index_size()
 * −−−−−−−−−−−−−−−
-* Prints message to stdout
+* Works out the number of slots in the hash index of a dictionary, a power
+* of two keeping it at most half full so probes stay short
 *
-* message: Output message
+* words: number of words in the dictionary
 *
-* Returns: Nothing
+* Returns: number of slots
 */
-void print_stdout(char* message) {
-    fprintf(stdout, "%s\n", message);
+unsigned int index_size(int words) {
+    //worked out on every lookup, so from the top bit rather than a loop
+    return words == 0 ? 1
+            : 1u << (CHAR_BIT * sizeof(unsigned int)
+            - __builtin_clz((unsigned int)words * 2 - 1));
 }
 
-/* in_dict()
+/* code_slot()
 * −−−−−−−−−−−−−−−
-* Check if the given word is in the dictionary
+* Works out the hash index slot a code's probe starts at
 *
-* word: given word to check
-* data: Struct containing all the data for the game.
+* code: code of the word
+* size: number of slots in the index
 *
-* Returns: boolean if word in dictionary
+* Returns: slot number
 */
-bool in_dict(char* word, Data data) {
-    for (int i = 0; i < data.wordsInDict; i++) {
-        if (strcmp(word, data.filteredDict[i]) == 0) {
-            return true;
-        }
-    }
-    return false;
+unsigned int code_slot(uint64_t code, unsigned int size) {
+    uint64_t hash = code * CODE_HASH;
+    return (hash ^ hash >> 32) & (size - 1);
 }
 
-/* previous_word()
+/* code_lookup()
 * −−−−−−−−−−−−−−−
-* Check if the given word was a previous word entered
+* Finds the index of the given word code in the dictionary by probing the
+* hash index. Each slot's code is kept beside it, so a probe never waits on
+* codes and a miss reads nothing but the slots.
 *
-* word: given word to check
-* data: Struct containing all the data for the game.
+* code: code of the word to find
+* dict: dictionary to search
 *
-* Returns: boolean if word was previous word
+* Returns: index of the code in codes or EMPTY_SLOT if not found
 */
-bool previous_word(Data data, char* word) {
-    for (int i = 0; i < data.attempt - 1; i++) {
-        if (strcmp(word, data.givenWords[i]) == 0) {
-            return true;
+int code_lookup(uint64_t code, const Dict* dict) {
+    unsigned int size = index_size(dict->wordsInDict);
+    //linear probing until the code or an empty slot is found
+    for (unsigned int slot = code_slot(code, size);;
+            slot = (slot + 1) & (size - 1)) {
+        uint64_t slotCode = dict->indexCodes[slot];
+        //a free slot holds 0 and EMPTY_SLOT, so code 0 (no word) misses
+        if (slotCode == code) {
+            return dict->index[slot];
+        }
+        if (slotCode == 0) {
+            return EMPTY_SLOT;
         }
     }
-    return false;
 }
 
-/* one_letter_diff()
+/* dict_lookup()
 * −−−−−−−−−−−−−−−
-* Check if the given word was a previous word entered
+* Finds the index of the given word in the dictionary
 *
-* word1: given word to check
-* word2: given word to check against
+* word: given uppercase word to find
+* dict: dictionary to search
 *
-* Returns: boolean the 2 words are only 1 letter different
+* Returns: index of word in codes or EMPTY_SLOT if not found
 */
-bool one_letter_diff(char* word1, char* word2) {
-    int diff = 0;
-    for (int i = 0; i < strlen(word1); i++) {
-        if (word1[i] != word2[i]) {
-            diff++;
+int dict_lookup(const char* word, const Dict* dict) {
+    return code_lookup(word_code(word), dict);
+}
+
+/* compare_codes()
+* −−−−−−−−−−−−−−−
+* qsort comparator for ascending word codes
+*
+* a: pointer to first code
+* b: pointer to second code
+*
+* Returns: negative, zero or positive as a is less, equal or greater than b
+*/
+int compare_codes(const void* a, const void* b) {
+    uint64_t first = *(const uint64_t*)a;
+    uint64_t second = *(const uint64_t*)b;
+    return (first > second) - (first < second);
+}
+
+/* index_codes()
+* −−−−−−−−−−−−−−−
+* Builds the hash index over the dictionary's unique codes
+*
+* dict: dictionary of one word length, or of every length
+*
+* Returns: Nothing
+*/
+void index_codes(Dict* dict) {
+    unsigned int size = index_size(dict->wordsInDict);
+    dict->index = arena_alloc(&dict->arena, sizeof(int) * size);
+    dict->indexCodes = arena_alloc(&dict->arena, sizeof(uint64_t) * size);
+    memset(dict->index, 0xff, sizeof(int) * size);
+    memset(dict->indexCodes, 0, sizeof(uint64_t) * size);
+    for (int i = 0; i < dict->wordsInDict; i++) {
+        unsigned int slot = code_slot(dict->codes[i], size);
+        while (dict->index[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & (size - 1);
         }
+        dict->index[slot] = i;
+        dict->indexCodes[slot] = dict->codes[i];
     }
-    if (diff == 1) {
-        return true;
-    }
-    return false;
 }
 
-/* print_suggestions()
+/* sort_dictionary()
 * −−−−−−−−−−−−−−−
-* Prints all vaild attempts user can make or no suggestions available
+* Sorts the word codes, dropping any duplicate words (e.g. "Ada" and "ada"
+* both become "ADA"), and indexes them for lookups
 *
-* data: Struct containing all the data for the game.
-* previous: given word to check against
+* dict: dictionary of one word length
 *
 * Returns: Nothing
 */
-void print_suggestions(Data data, char* previous) {    
-    //Check if given word is final word
-    if (one_letter_diff(previous, data.toWord) == true) {
-        data.sugWords[data.sugWordsLen] = strdup(data.toWord);
-        data.sugWordsLen++;
-    } 
-    //adds all valid words to array
-    for (int i = 0; i < data.wordsInDict; i++) {
-        if (one_letter_diff(previous, data.filteredDict[i]) == true
-                && previous_word(data, data.filteredDict[i]) == false
-                && strcmp(data.filteredDict[i], data.toWord) != 0
-                && strcmp(data.filteredDict[i], data.initWord) != 0) {
-            data.sugWords = realloc(data.sugWords, 
-                    sizeof(char*) * (data.sugWordsLen + 1));
-            data.sugWords[data.sugWordsLen] = strdup(data.filteredDict[i]);
-            data.sugWordsLen++;
-        }
-    }
-    if (data.sugWordsLen == 0) {
-        print_stdout("No suggestions available.");
-    } else {
-        print_stdout("Suggestions:-----------");
-        for (int i = 0; i < data.sugWordsLen; i++) {
-            fprintf(stdout, " %s\n", data.sugWords[i]);
+void sort_dictionary(Dict* dict) {
+    qsort(dict->codes, dict->wordsInDict, sizeof(uint64_t), compare_codes);
+    int unique = 0;
+    for (int i = 0; i < dict->wordsInDict; i++) {
+        if (unique == 0 || dict->codes[i] != dict->codes[unique - 1]) {
+            dict->codes[unique++] = dict->codes[i];
         }
-        print_stdout("-----End of Suggestions");
     }
+    dict->wordsInDict = unique;
+    index_codes(dict);
 }
 
-/* check_input()
+/* bucket_words()
 * −−−−−−−−−−−−−−−
-* Gets user input and checks if it is valid
+* Groups the dictionary into wildcard buckets for one letter position, so
+* "COT" and "CAT" both land in bucket "C?T" for position 1
 *
-* data: Struct containing all the data for the game.
-* input: users input
+* dict: dictionary of one word length
+* position: index of the letter replaced by the wildcard
+* bucketOf: filled with the bucket number of each word
+* bucketSize: filled with the number of words in each bucket
 *
-* Returns: Updated data
-* Errors: Message prints and exits if game won or step limit reached 
+* Returns: number of buckets
 */
-Data check_input(char input[MAX_LENGTH + 2], Data data){
-    if (strcmp(input, "?") == 0) {
-        if (data.attempt == 1) {
-            print_suggestions(data, data.initWord);
+int bucket_words(const Dict* dict, unsigned int position, int* bucketOf,
+        int* bucketSize) {
+    //hash table of representatives, kept at most half full
+    unsigned int tableSize = 1;
+    while (tableSize < (unsigned int)dict->wordsInDict * 2) {
+        tableSize <<= 1;
+    }
+    unsigned int mask = tableSize - 1;
+    int* table = stats_malloc(sizeof(int) * tableSize);
+    memset(table, 0xff, sizeof(int) * tableSize);
+    //the wildcard clears the letter at position from the codes
+    uint64_t wildcard = ~((uint64_t)LETTER_MASK
+            << LETTER_BITS * (dict->wordLen - 1 - position));
+    int buckets = 0;
+    for (int i = 0; i < dict->wordsInDict; i++) {
+        uint64_t pattern = dict->codes[i] & wildcard;
+        unsigned int slot = (pattern * CODE_HASH >> 32) & mask;
+        while (table[slot] != EMPTY_SLOT
+                && (dict->codes[table[slot]] & wildcard) != pattern) {
+            slot = (slot + 1) & mask;
+        }
+        if (table[slot] == EMPTY_SLOT) {
+            //first word of a new bucket represents it
+            table[slot] = i;
+            bucketSize[buckets] = 0;
+            bucketOf[i] = buckets++;
         } else {
-            print_suggestions(data, data.givenWords[data.attempt - 2]);
+            bucketOf[i] = bucketOf[table[slot]];
         }
-    } else if (strlen(input) != data.wordLen) {
-        fprintf(stdout, "Word should have %d characters - try again.\n",
-                data.wordLen);
-    } else if (check_chars(input) == false) {
-        print_stdout(ONLY_LETTERS);
-    } else if (( data.attempt == 1 && one_letter_diff(input, data.initWord) 
-            == false) || (data.attempt > 1 && one_letter_diff(input,
-            data.givenWords[data.attempt - 2]) == false)) { 
-            //-2 cause attempt starts at 1
-        print_stdout(DIFFER_ONE);
-    } else if (strcmp(input, data.initWord) == 0 || 
-            (data.attempt > 1 && previous_word(data, input) == true)) {
-        print_stdout(NO_PREVIOUS);
-    } else if (in_dict(input, data) == false) {
-        print_stdout(NOT_IN_DICT);
-    } else if (strcmp(input, data.toWord) == 0) {
-        fprintf(stdout, "Well done - you solved the ladder in %d steps.\n",
-                data.attempt);
-        my_exit(0, data);
-    } else if (data.attempt == data.stepLim) {
-        print_stdout(GAME_OVER);
-        my_exit(12, data);
-    } else {
-        //increases size of array and adds given valid word to it
-        data.givenWords = (char**)realloc(data.givenWords, 
-                sizeof(char*) * (data.attempt));
-        data.givenWords[data.attempt - 1] = strdup(input);
-        data.attempt++;
+        bucketSize[bucketOf[i]]++;
     }
-    return data;
+    free(table);
+    return buckets;
 }
 
-/* game_loop()
+/* compare_ints()
 * −−−−−−−−−−−−−−−
-* Gets user input and checks if it is valid
+* qsort comparator for ascending ints
 *
-* data: Struct containing all the data for the game.
+* a: pointer to first int
+* b: pointer to second int
 *
-* Returns: Nothing
-* Errors: Message prints and exits if exited 
-* REF: Used Chat-GPT to convered my function with fgets, to something with
-* REF: dynamically allocated memory. Which it gave getline.
-* REF: Which was changed to fit styleguide and comments added to show my 
-* REF: understanding of the function.
+* Returns: negative, zero or positive as a is less, equal or greater than b
 */
-void game_loop(Data data) {
-    char* input = NULL; // Initialize input pointer to NULL
-    size_t inputSize = 0; // Initialize inputSize to 0
+int compare_ints(const void* a, const void* b) {
+    int first = *(const int*)a;
+    int second = *(const int*)b;
+    return (first > second) - (first < second);
+}
 
-    while (1) {
-        fprintf(stdout, ENTER_WORD, data.attempt);
-        // getline() reads the whole line from stdin.
-        // since input is NULL and inputSize 0
-        // getline will allocate sufficent memory for input
-        if (getline(&input, &inputSize, stdin) == -1) {
+/* build_neighbours()
+* −−−−−−−−−−−−−−−
+* Builds the one letter neighbour graph of the dictionary in CSR form. Words
+* sharing a wildcard bucket are neighbours, so this is O(N * L) plus the
+* number of edges rather than comparing every pair of words.
+*
+* dict: dictionary of one word length
+*
+* Returns: Nothing
+*/
+void build_neighbours(Dict* dict) {
+    int words = dict->wordsInDict;
+    int* bucketOf = stats_malloc(sizeof(int) * words * dict->wordLen);
+    int* bucketSize = stats_malloc(sizeof(int) * words * dict->wordLen);
+    int* bucketCount = stats_malloc(sizeof(int) * dict->wordLen);
+    dict->neighStart = arena_alloc(&dict->arena, sizeof(int) * (words + 1));
+    memset(dict->neighStart, 0, sizeof(int) * (words + 1));
+    //first pass counts the degree of every word
+    for (unsigned int p = 0; p < dict->wordLen; p++) {
+        int* of = bucketOf + p * words;
+        int* size = bucketSize + p * words;
+        bucketCount[p] = bucket_words(dict, p, of, size);
+        for (int i = 0; i < words; i++) {
+            dict->neighStart[i + 1] += size[of[i]] - 1;
+        }
+    }
+    for (int i = 0; i < words; i++) {
+        dict->neighStart[i + 1] += dict->neighStart[i];
+    }
+    dict->neighbours = arena_alloc(&dict->arena,
+            sizeof(int) * (dict->neighStart[words] + 1));
+    //second pass lists each bucket's members and links them together
+    int* fill = stats_malloc(sizeof(int) * (words + 1));
+    int* members = stats_malloc(sizeof(int) * (words + 1));
+    int* memberStart = stats_malloc(sizeof(int) * (words + 1));
+    memcpy(fill, dict->neighStart, sizeof(int) * words);
+    for (unsigned int p = 0; p < dict->wordLen; p++) {
+        int* of = bucketOf + p * words;
+        int* size = bucketSize + p * words;
+        memberStart[0] = 0;
+        for (int b = 0; b < bucketCount[p]; b++) {
+            memberStart[b + 1] = memberStart[b] + size[b];
+            size[b] = memberStart[b];
+        }
+        for (int i = 0; i < words; i++) {
+            members[size[of[i]]++] = i;
+        }
+        for (int i = 0; i < words; i++) {
+            for (int m = memberStart[of[i]]; m < memberStart[of[i] + 1];
+                    m++) {
+                if (members[m] != i) {
+                    dict->neighbours[fill[i]++] = members[m];
+                }
+            }
+        }
+    }
+    //keeps each word's neighbours in dictionary order
+    for (int i = 0; i < words; i++) {
+        qsort(dict->neighbours + dict->neighStart[i],
+                dict->neighStart[i + 1] - dict->neighStart[i], sizeof(int),
+                compare_ints);
+    }
+    free(memberStart);
+    free(members);
+    free(fill);
+    free(bucketCount);
+    free(bucketSize);
+    free(bucketOf);
+}
+
+/* find_deletions()
+* −−−−−−−−−−−−−−−
+* Finds every word that becomes a word one letter shorter with a letter
+* deleted, by looking up each deletion in the shorter length. The links
+* grow by doubling.
+*
+* dicts: dictionary of each word length, filled for MIN_LENGTH to MAX_LENGTH
+* base: index in the dictionary of any length of each length's first word
+* links: filled with the pairs of longer and shorter words linked
+*
+* Returns: number of pairs found
+*/
+int find_deletions(const Dict dicts[], const int base[], int** links) {
+    int capacity = PACK_WORDS;
+    int found = 0;
+    *links = stats_malloc(sizeof(int) * 2 * capacity);
+    for (unsigned int length = MIN_LENGTH + 1; length <= MAX_LENGTH;
+            length++) {
+        const Dict* dict = &dicts[length];
+        for (int i = 0; i < dict->wordsInDict; i++) {
+            uint64_t code = dict->codes[i];
+            for (unsigned int p = 0; p < length; p++) {
+                unsigned int shift = LETTER_BITS * (length - 1 - p);
+                //deleting any letter of a run gives the same word
+                if (p > 0 && (code >> shift & LETTER_MASK)
+                        == (code >> (shift + LETTER_BITS) & LETTER_MASK)) {
+                    continue;
+                }
+                uint64_t deleted = code >> (shift + LETTER_BITS) << shift
+                        | (code & (((uint64_t)1 << shift) - 1));
+                int shorter = code_lookup(deleted, &dicts[length - 1]);
+                if (shorter == EMPTY_SLOT) {
+                    continue;
+                }
+                if (found == capacity) {
+                    capacity *= 2;
+                    *links = stats_realloc(*links, sizeof(int) * 2 * capacity);
+                }
+                (*links)[2 * found] = base[length] + i;
+                (*links)[2 * found + 1] = base[length - 1] + shorter;
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+/* build_edit_dict()
+* −−−−−−−−−−−−−−−
+* Joins the dictionaries of every length into the dictionary of any length,
+* where words one letter substituted, inserted or deleted apart are
+* neighbours. Shorter words always have smaller codes, so joining the codes
+* in length order keeps them sorted. Substitutions are copied from each
+* length's own graph, and insertions and deletions are the deletion
+* neighbourhood of each word looked up in the length below, so building
+* stays O(N * L) lookups rather than comparing words across lengths.
+*
+* dicts: dictionary of each word length, filled for MIN_LENGTH to MAX_LENGTH
+*
+* Returns: Nothing
+*/
+void build_edit_dict(Dict dicts[]) {
+    Dict* edit = &dicts[ANY_LENGTH];
+    memset(edit, 0, sizeof(Dict));
+    edit->wordLen = ANY_LENGTH;
+    int base[MAX_LENGTH + 2];
+    base[MIN_LENGTH] = 0;
+    for (unsigned int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        base[length + 1] = base[length] + dicts[length].wordsInDict;
+    }
+    int words = base[MAX_LENGTH + 1];
+    edit->wordsInDict = words;
+    edit->codes = arena_alloc(&edit->arena, sizeof(uint64_t) * (words + 1));
+    edit->neighStart = arena_alloc(&edit->arena, sizeof(int) * (words + 1));
+    memset(edit->neighStart, 0, sizeof(int) * (words + 1));
+    //first pass counts the degree of every word
+    for (unsigned int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        const Dict* dict = &dicts[length];
+        memcpy(edit->codes + base[length], dict->codes,
+                sizeof(uint64_t) * dict->wordsInDict);
+        for (int i = 0; i < dict->wordsInDict; i++) {
+            edit->neighStart[base[length] + i + 1] = dict->neighStart[i + 1]
+                    - dict->neighStart[i];
+        }
+    }
+    index_codes(edit);
+    int* links;
+    int linkCount = find_deletions(dicts, base, &links);
+    for (int i = 0; i < 2 * linkCount; i++) {
+        edit->neighStart[links[i] + 1]++;
+    }
+    for (int i = 0; i < words; i++) {
+        edit->neighStart[i + 1] += edit->neighStart[i];
+    }
+    edit->neighbours = arena_alloc(&edit->arena,
+            sizeof(int) * (edit->neighStart[words] + 1));
+    //second pass fills the rows, substitutions first
+    int* fill = stats_malloc(sizeof(int) * (words + 1));
+    memcpy(fill, edit->neighStart, sizeof(int) * words);
+    for (unsigned int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        const Dict* dict = &dicts[length];
+        for (int i = 0; i < dict->wordsInDict; i++) {
+            int word = base[length] + i;
+            for (int n = dict->neighStart[i]; n < dict->neighStart[i + 1];
+                    n++) {
+                edit->neighbours[fill[word]++] = base[length]
+                        + dict->neighbours[n];
+            }
+        }
+    }
+    for (int i = 0; i < linkCount; i++) {
+        int longer = links[2 * i];
+        int shorter = links[2 * i + 1];
+        edit->neighbours[fill[longer]++] = shorter;
+        edit->neighbours[fill[shorter]++] = longer;
+    }
+    //keeps each word's neighbours in dictionary order
+    for (int i = 0; i < words; i++) {
+        qsort(edit->neighbours + edit->neighStart[i],
+                edit->neighStart[i + 1] - edit->neighStart[i], sizeof(int),
+                compare_ints);
+    }
+    free(links);
+    free(fill);
+}
+
+/* read_file()
+* −−−−−−−−−−−−−−−
+* Reads a whole file into memory in one go. Regular files are mapped if
+* allowed, anything else (e.g. a pipe) is read in large chunks.
+*
+* file: descriptor of the open file
+* mayMap: if a regular file may be mapped rather than read
+* size: filled with the number of bytes read
+* mapped: filled with if the result must be unmapped rather than freed
+*
+* Returns: pointer to the file contents
+*/
+char* read_file(int file, bool mayMap, size_t* size, bool* mapped) {
+    struct stat info;
+    if (mayMap == true && fstat(file, &info) == 0
+            && S_ISREG(info.st_mode) && info.st_size > 0) {
+        char* text = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, file,
+                0);
+        if (text != MAP_FAILED) {
+            madvise(text, info.st_size, MADV_SEQUENTIAL);
+            *size = info.st_size;
+            *mapped = true;
+            return text;
+        }
+    }
+    size_t capacity = READ_CHUNK;
+    char* text = stats_malloc(capacity);
+    ssize_t got;
+    *size = 0;
+    *mapped = false;
+    while ((got = read(file, text + *size, capacity - *size)) > 0) {
+        *size += got;
+        if (*size == capacity) {
+            capacity *= 2;
+            text = stats_realloc(text, capacity);
+        }
+    }
+    return text;
+}
+
+/* pack_words()
+* −−−−−−−−−−−−−−−
+* Filters the dictionary text in a single pass, packing every word of only
+* letters into the code array of its length. Only lengths
+* that weren't mapped from a cache are packed. The arrays grow by doubling.
+* Lines may end in CRLF, and overlong lines are skipped without copying.
+*
+* dicts: dictionary of each word length
+* first: shortest word length packed
+* last: longest word length packed
+* text: contents of the dictionary file
+* size: number of bytes in text
+*
+* Returns: Nothing
+*/
+void pack_words(Dict dicts[], unsigned int first, unsigned int last,
+        const char* text, size_t size) {
+    int capacity[MAX_LENGTH + 1];
+    for (unsigned int length = first; length <= last; length++) {
+        capacity[length] = 0;
+        if (dicts[length].cache == NULL) {
+            capacity[length] = PACK_WORDS;
+            dicts[length].codes = stats_malloc(sizeof(uint64_t) * PACK_WORDS);
+        }
+    }
+    const char* end = text + size;
+    long long lines = 0;
+    long long accepted = 0;
+    while (text < end) {
+        const char* line = text;
+        const char* newline = memchr(text, '\n', end - text);
+        text = newline == NULL ? end : newline + 1;
+        lines++;
+        size_t length = (newline == NULL ? end : newline) - line;
+        if (length > 0 && line[length - 1] == '\r') {
+            length--;
+        }
+        if (length < first || length > last || capacity[length] == 0) {
+            continue;
+        }
+        Dict* dict = &dicts[length];
+        if (dict->wordsInDict == capacity[length]) {
+            capacity[length] *= 2;
+            dict->codes = stats_realloc(dict->codes,
+                    sizeof(uint64_t) * capacity[length]);
+        }
+        uint64_t code = 0;
+        size_t i = 0;
+        while (i < length && isalpha((unsigned char)line[i])) {
+            code = code << LETTER_BITS
+                    | (uint64_t)(toupper((unsigned char)line[i]) - 'A' + 1);
+            i++;
+        }
+        if (i == length) {
+            dict->codes[dict->wordsInDict++] = code;
+            accepted++;
+        }
+    }
+    //packing threads share the counters
+    __atomic_fetch_add(&stats.linesScanned, lines, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats.wordsAccepted, accepted, __ATOMIC_RELAXED);
+}
+
+/*Part of the dictionary text packed by one loading thread*/
+typedef struct {
+    const char* text; //start of the part, just after a newline
+    size_t size; //number of bytes in the part
+    unsigned int first; //shortest word length packed
+    unsigned int last; //longest word length packed
+    Dict dicts[MAX_LENGTH + 1]; //words of each length found in the part
+    bool threaded; //if a thread was started for the part, to be joined
+} PackChunk;
+
+/* pack_chunk()
+* −−−−−−−−−−−−−−−
+* Thread packing the words of one part of the dictionary text
+*
+* arg: PackChunk to pack
+*
+* Returns: NULL
+*/
+void* pack_chunk(void* arg) {
+    PackChunk* chunk = arg;
+    pack_words(chunk->dicts, chunk->first, chunk->last, chunk->text,
+            chunk->size);
+    return NULL;
+}
+
+/* pack_parallel()
+* −−−−−−−−−−−−−−−
+* Packs large dictionaries with one thread per processor, small ones on
+* this thread. The text is cut into parts at newlines, each thread packs
+* its part into its own arrays, and the parts are joined in file order
+* into the dictionary's arena, so the result is the same as pack_words()
+* on the whole text. Duplicates are left for
+* sort_dictionary() to drop, as they would be from a single thread.
+*
+* dicts: dictionary of each word length
+* first: shortest word length packed
+* last: longest word length packed
+* text: contents of the dictionary file
+* size: number of bytes in text
+*
+* Returns: Nothing
+*/
+void pack_parallel(Dict dicts[], unsigned int first, unsigned int last,
+        const char* text, size_t size) {
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t parts = size / PACK_CHUNK + 1;
+    int threadCount = processors < 1 ? 1
+            : (size_t)processors < parts ? (int)processors : (int)parts;
+    PackChunk* chunks = stats_calloc(threadCount, sizeof(PackChunk));
+    pthread_t* threads = stats_malloc(sizeof(pthread_t) * threadCount);
+    const char* start = text;
+    const char* end = text + size;
+    for (int i = 0; i < threadCount; i++) {
+        //each part runs on to the end of the line it was cut in
+        const char* stop = i == threadCount - 1 ? end
+                : text + size / threadCount * (i + 1);
+        if (stop < start) {
+            stop = start;
+        }
+        const char* newline = stop < end ? memchr(stop, '\n', end - stop)
+                : NULL;
+        stop = newline == NULL ? end : newline + 1;
+        chunks[i].text = start;
+        chunks[i].size = stop - start;
+        chunks[i].first = first;
+        chunks[i].last = last;
+        for (unsigned int length = first; length <= last; length++) {
+            //cached lengths are skipped by the threads too
+            chunks[i].dicts[length].cache = dicts[length].cache;
+        }
+        //a part no thread could be started for is packed right here
+        chunks[i].threaded = threadCount > 1 && pthread_create(&threads[i],
+                NULL, pack_chunk, &chunks[i]) == 0;
+        if (chunks[i].threaded == false) {
+            pack_chunk(&chunks[i]);
+        }
+        start = stop;
+    }
+    for (int i = 0; i < threadCount; i++) {
+        if (chunks[i].threaded == true) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    for (unsigned int length = first; length <= last; length++) {
+        Dict* dict = &dicts[length];
+        if (dict->cache != NULL) {
+            continue;
+        }
+        for (int i = 0; i < threadCount; i++) {
+            dict->wordsInDict += chunks[i].dicts[length].wordsInDict;
+        }
+        dict->codes = arena_alloc(&dict->arena,
+                sizeof(uint64_t) * (dict->wordsInDict + 1));
+        uint64_t* code = dict->codes;
+        for (int i = 0; i < threadCount; i++) {
+            Dict* part = &chunks[i].dicts[length];
+            memcpy(code, part->codes, sizeof(uint64_t) * part->wordsInDict);
+            code += part->wordsInDict;
+            free(part->codes);
+        }
+    }
+    free(threads);
+    free(chunks);
+}
+
+/* cache_align()
+* −−−−−−−−−−−−−−−
+* Rounds a size up so the next section of the cache is aligned
+*
+* size: number of bytes
+*
+* Returns: size rounded up to a multiple of CACHE_ALIGN
+*/
+size_t cache_align(size_t size) {
+    return (size + CACHE_ALIGN - 1) / CACHE_ALIGN * CACHE_ALIGN;
+}
+
+/* cache_header()
+* −−−−−−−−−−−−−−−
+* Fills in the cache header describing the dictionary file and its sections
+*
+* dict: dictionary of one word length
+* info: status of the dictionary file
+* path: absolute path of the dictionary file
+*
+* Returns: header for the cache of this dictionary
+*/
+CacheHeader cache_header(const Dict* dict, struct stat info, const char* path) {
+    CacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.wordLen = dict->wordLen;
+    header.pathLen = strlen(path);
+    header.dictSize = info.st_size;
+    header.mtimeSec = info.st_mtim.tv_sec;
+    header.mtimeNsec = info.st_mtim.tv_nsec;
+    header.inode = info.st_ino;
+    header.wordsInDict = dict->wordsInDict;
+    header.edges = dict->wordsInDict > 0 ? dict->neighStart[dict->wordsInDict]
+            : 0;
+    return header;
+}
+
+/* cache_size()
+* −−−−−−−−−−−−−−−
+* Works out the size of a cache file from its header
+*
+* header: header of the cache
+*
+* Returns: number of bytes in the whole cache file
+*/
+size_t cache_size(CacheHeader header) {
+    return sizeof(CacheHeader) + cache_align(header.pathLen)
+            + cache_align(sizeof(uint64_t) * header.wordsInDict)
+            + cache_align(sizeof(int) * (header.wordsInDict + 1))
+            + cache_align(sizeof(int) * header.edges)
+            + cache_align(sizeof(uint64_t) * index_size(header.wordsInDict))
+            + cache_align(sizeof(int) * index_size(header.wordsInDict));
+}
+
+/* code_valid()
+* −−−−−−−−−−−−−−−
+* Checks a code from a cache is a word of the given length, every letter 1
+* to 26 and nothing set above its last letter
+*
+* code: code to check
+* length: number of letters the word must have
+*
+* Returns: boolean if the code is a word of that length
+*/
+bool code_valid(uint64_t code, unsigned int length) {
+    for (unsigned int i = 0; i < length; i++) {
+        uint64_t letter = code & LETTER_MASK;
+        if (letter == 0 || letter > ALPHABET) {
+            return false;
+        }
+        code >>= LETTER_BITS;
+    }
+    return code == 0;
+}
+
+/* cache_valid()
+* −−−−−−−−−−−−−−−
+* Checks the arrays of a mapped cache before they are used, so a damaged
+* cache can't send lookups or walks outside the dictionary. Rows are at
+* most wordLen * (ALPHABET - 1) long, as every neighbour buffer assumes.
+*
+* dict: dictionary pointing into the mapped cache
+* edges: number of entries in the neighbour array
+*
+* Returns: boolean if the codes are sorted words of the dictionary's length,
+* every row of neighbours is in range, short enough and not self-linked,
+* and the hash index holds every word once, beside its code
+*/
+bool cache_valid(const Dict* dict, int edges) {
+    int words = dict->wordsInDict;
+    int maxRow = dict->wordLen * (ALPHABET - 1);
+    if (words < 0 || edges < 0 || dict->neighStart[0] != 0
+            || dict->neighStart[words] != edges) {
+        return false;
+    }
+    for (int i = 0; i < words; i++) {
+        if ((i > 0 && dict->codes[i] <= dict->codes[i - 1])
+                || code_valid(dict->codes[i], dict->wordLen) == false
+                || dict->neighStart[i + 1] < dict->neighStart[i]
+                || dict->neighStart[i + 1] > edges
+                || dict->neighStart[i + 1] - dict->neighStart[i] > maxRow) {
+            return false;
+        }
+        for (int n = dict->neighStart[i]; n < dict->neighStart[i + 1]; n++) {
+            if (dict->neighbours[n] < 0 || dict->neighbours[n] >= words
+                    || dict->neighbours[n] == i) {
+                return false;
+            }
+        }
+    }
+    //every word in one slot leaves free slots, so probes always end
+    unsigned int size = index_size(words);
+    int used = 0;
+    for (unsigned int slot = 0; slot < size; slot++) {
+        int index = dict->index[slot];
+        if (index == EMPTY_SLOT ? dict->indexCodes[slot] != 0
+                : index < 0 || index >= words
+                || dict->indexCodes[slot] != dict->codes[index]) {
+            return false;
+        }
+        used += index != EMPTY_SLOT;
+    }
+    return used == words;
+}
+
+/* load_cache()
+* −−−−−−−−−−−−−−−
+* Maps the dictionary cache and points the dictionary arrays into it, if the
+* cache was made from the same version of the same file for this length and
+* its arrays are sound
+*
+* dict: dictionary of one word length
+* cachePath: location of the cache file
+* info: status of the dictionary file
+* path: absolute path of the dictionary file
+*
+* Returns: Nothing, cache is only set if the cache was used
+*/
+void load_cache(Dict* dict, const char* cachePath, struct stat info,
+        const char* path) {
+    int file = open(cachePath, O_RDONLY);
+    struct stat cacheInfo;
+    if (file == -1 || fstat(file, &cacheInfo) == -1
+            || (size_t)cacheInfo.st_size < sizeof(CacheHeader)) {
+        if (file != -1) {
+            close(file);
+        }
+        return;
+    }
+    char* map = mmap(NULL, cacheInfo.st_size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    if (map == MAP_FAILED) {
+        return;
+    }
+    CacheHeader header;
+    memcpy(&header, map, sizeof(header));
+    CacheHeader expected = cache_header(dict, info, path);
+    if (header.magic != expected.magic || header.version != expected.version
+            || header.wordLen != expected.wordLen
+            || header.pathLen != expected.pathLen
+            || header.dictSize != expected.dictSize
+            || header.mtimeSec != expected.mtimeSec
+            || header.mtimeNsec != expected.mtimeNsec
+            || header.inode != expected.inode
+            || cache_size(header) != (size_t)cacheInfo.st_size
+            || memcmp(map + sizeof(header), path, header.pathLen) != 0) {
+        munmap(map, cacheInfo.st_size);
+        return;
+    }
+    char* section = map + sizeof(header) + cache_align(header.pathLen);
+    dict->wordsInDict = header.wordsInDict;
+    dict->codes = (uint64_t*)section;
+    section += cache_align(sizeof(uint64_t) * header.wordsInDict);
+    dict->neighStart = (int*)section;
+    section += cache_align(sizeof(int) * (header.wordsInDict + 1));
+    dict->neighbours = (int*)section;
+    section += cache_align(sizeof(int) * header.edges);
+    dict->indexCodes = (uint64_t*)section;
+    section += cache_align(sizeof(uint64_t) * index_size(header.wordsInDict));
+    dict->index = (int*)section;
+    if (cache_valid(dict, header.edges) == false) {
+        munmap(map, cacheInfo.st_size);
+        dict->wordsInDict = 0;
+        dict->codes = NULL;
+        dict->index = NULL;
+        dict->indexCodes = NULL;
+        dict->neighStart = NULL;
+        dict->neighbours = NULL;
+        return;
+    }
+    dict->cache = map;
+    dict->cacheSize = cacheInfo.st_size;
+}
+
+/* write_section()
+* −−−−−−−−−−−−−−−
+* Writes one section of the cache followed by its alignment padding
+*
+* file: open cache file
+* section: bytes to write
+* size: number of bytes in section
+*
+* Returns: boolean if the whole section was written
+*/
+bool write_section(FILE* file, const void* section, size_t size) {
+    static const char padding[CACHE_ALIGN] = {0};
+    size_t pad = cache_align(size) - size;
+    return fwrite(section, 1, size, file) == size
+            && fwrite(padding, 1, pad, file) == pad;
+}
+
+/* save_cache()
+* −−−−−−−−−−−−−−−
+* Writes the dictionary arrays to the cache. The cache is written to a
+* temporary file first and renamed into place, so other runs only ever see
+* a complete cache. Failing to write the cache is not an error.
+*
+* dict: dictionary of one word length
+* cachePath: location of the cache file
+* info: status of the dictionary file
+* path: absolute path of the dictionary file
+*
+* Returns: Nothing
+*/
+void save_cache(const Dict* dict, const char* cachePath, struct stat info,
+        const char* path) {
+    char tempPath[PATH_MAX + CACHE_ALIGN * 4];
+    snprintf(tempPath, sizeof(tempPath), CACHE_TEMP, cachePath, getpid());
+    FILE* file = fopen(tempPath, "w");
+    if (file == NULL) {
+        return;
+    }
+    CacheHeader header = cache_header(dict, info, path);
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+            && write_section(file, path, header.pathLen)
+            && write_section(file, dict->codes,
+            sizeof(uint64_t) * dict->wordsInDict)
+            && write_section(file, dict->neighStart,
+            sizeof(int) * (dict->wordsInDict + 1))
+            && write_section(file, dict->neighbours,
+            sizeof(int) * header.edges)
+            && write_section(file, dict->indexCodes,
+            sizeof(uint64_t) * index_size(dict->wordsInDict))
+            && write_section(file, dict->index,
+            sizeof(int) * index_size(dict->wordsInDict));
+    if (fclose(file) != 0 || written == false
+            || rename(tempPath, cachePath) != 0) {
+        unlink(tempPath);
+    }
+}
+
+/* cache_path()
+* −−−−−−−−−−−−−−−
+* Works out where the cache for a dictionary and word length is kept, in
+* $UQWORDLADDER_CACHE, or else the user's cache directory: $XDG_CACHE_HOME
+* or ~/.cache, which is made if missing
+*
+* dict: dictionary of one word length
+* path: absolute path of the dictionary file
+* cachePath: filled with the location of the cache file
+*
+* Returns: boolean if there is somewhere to keep the cache
+*/
+bool cache_path(const Dict* dict, const char* path, char cachePath[PATH_MAX]) {
+    char dir[PATH_MAX];
+    const char* chosen = getenv(CACHE_ENV);
+    const char* xdg = getenv(CACHE_XDG_ENV);
+    const char* home = getenv("HOME");
+    if (chosen != NULL) {
+        //set but empty turns caching off
+        if (chosen[0] == '\0') {
+            return false;
+        }
+        snprintf(dir, PATH_MAX, "%s", chosen);
+    } else if (xdg != NULL && xdg[0] == '/') {
+        //relative paths are invalid in $XDG_CACHE_HOME
+        snprintf(dir, PATH_MAX, "%s", xdg);
+        mkdir(dir, S_IRWXU);
+    } else if (home != NULL && home[0] != '\0') {
+        snprintf(dir, PATH_MAX, CACHE_HOME, home);
+        mkdir(dir, S_IRWXU);
+    } else {
+        return false;
+    }
+    return snprintf(cachePath, PATH_MAX, CACHE_NAME, dir, hash_word(path),
+            dict->wordLen) < PATH_MAX;
+}
+
+/* load_dictionaries()
+* −−−−−−−−−−−−−−−
+* Reads the dictionary file once for a range of word lengths, packing the
+* words of each length into their own sorted, hash indexed code array for
+* lookups and linking one letter neighbours. Each length is cached
+* separately, so later runs map the caches instead while the dictionary
+* file is unchanged, and only read the file if a cache is missing.
+*
+* dicts: dictionary of each word length, filled for first to last
+* path: dictionary file location
+* first: shortest word length loaded
+* last: longest word length loaded
+* mayMap: if the file may be mapped rather than read. Anything that reloads
+* while the file may be rewritten must read it, as a mapped file shrinking
+* underneath would kill the process with SIGBUS.
+*
+* Returns: boolean if the dictionary file could be opened
+*/
+bool load_dictionaries(Dict dicts[], const char* path, unsigned int first,
+        unsigned int last, bool mayMap) {
+    long long start = stats.enabled ? stats_now() : 0;
+    int file = open(path, O_RDONLY);
+    if (file == -1){
+        return false;
+    }
+    //only regular files are cached, their changes show in their status
+    struct stat info;
+    char fullPath[PATH_MAX];
+    char cachePaths[MAX_LENGTH + 1][PATH_MAX];
+    bool cacheable[MAX_LENGTH + 1];
+    bool regular = fstat(file, &info) == 0 && S_ISREG(info.st_mode)
+            && realpath(path, fullPath) != NULL;
+    bool missing = false;
+    for (unsigned int length = first; length <= last; length++) {
+        Dict* dict = &dicts[length];
+        memset(dict, 0, sizeof(Dict));
+        dict->wordLen = length;
+        cacheable[length] = regular
+                && cache_path(dict, fullPath, cachePaths[length]);
+        if (cacheable[length] == true) {
+            load_cache(dict, cachePaths[length], info, fullPath);
+        }
+        missing = missing || dict->cache == NULL;
+    }
+    if (missing == false) {
+        close(file);
+        stats.loadNs += stats.enabled ? stats_now() - start : 0;
+        return true;
+    }
+    bool mapped;
+    size_t size;
+    char* text = read_file(file, mayMap, &size, &mapped);
+    //closes file
+    close(file);
+    pack_parallel(dicts, first, last, text, size);
+    if (mapped == true) {
+        munmap(text, size);
+    } else {
+        free(text);
+    }
+    for (unsigned int length = first; length <= last; length++) {
+        Dict* dict = &dicts[length];
+        if (dict->cache == NULL) {
+            sort_dictionary(dict);
+            build_neighbours(dict);
+            if (cacheable[length] == true) {
+                save_cache(dict, cachePaths[length], info, fullPath);
+            }
+        }
+    }
+    stats.loadNs += stats.enabled ? stats_now() - start : 0;
+    return true;
+}
+
+/* default_embedded()
+* −−−−−−−−−−−−−−−
+* Check if the dictionary is the one compiled in, which it is when built
+* with EMBED_DICT and no --dict is given
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: boolean if the compiled in dictionary is used
+*/
+bool default_embedded(const Data* data) {
+#ifdef EMBED_DICT
+    return data->dictSet == false;
+#else
+    return false;
+#endif
+}
+
+/* load_words()
+* −−−−−−−−−−−−−−−
+* Loads the dictionaries of a range of word lengths. The compiled in
+* dictionary is read only data in the program already laid out as the
+* dictionary arrays, so it is pointed to without any file I/O or parsing,
+* as a mapped cache is. Otherwise the dictionary file is loaded.
+*
+* data: Struct containing all the data for the game.
+* dicts: dictionary of each word length, filled for first to last
+* first: shortest word length loaded
+* last: longest word length loaded
+* mayMap: if the dictionary file may be mapped rather than read
+*
+* Returns: boolean if the dictionary file could be opened
+*/
+bool load_words(const Data* data, Dict dicts[], unsigned int first,
+        unsigned int last, bool mayMap) {
+    if (default_embedded(data) == false) {
+        return load_dictionaries(dicts, data->dict, first, last, mayMap);
+    }
+#ifdef EMBED_DICT
+    for (unsigned int length = first; length <= last; length++) {
+        Dict* dict = &dicts[length];
+        memset(dict, 0, sizeof(Dict));
+        dict->wordLen = length;
+        dict->wordsInDict = embeddedWords[length];
+        //the tables are never written through these, like a mapped cache
+        dict->codes = (uint64_t*)embeddedCodes[length];
+        dict->index = (int*)embeddedIndex[length];
+        dict->indexCodes = (uint64_t*)embeddedIndexCodes[length];
+        dict->neighStart = (int*)embeddedNeighStart[length];
+        dict->neighbours = (int*)embeddedNeighbours[length];
+    }
+#endif
+    return true;
+}
+
+/* load_game_dictionary()
+* −−−−−−−−−−−−−−−
+* Loads the dictionary the game on stdin is played with: the chosen word
+* length, or every length joined together for --edit
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: boolean if the dictionary file could be opened
+*/
+bool load_game_dictionary(Data* data) {
+    if (data->edit == false) {
+        return load_words(data, data->dicts, data->wordLen, data->wordLen,
+                true);
+    }
+    if (load_words(data, data->dicts, MIN_LENGTH, MAX_LENGTH, true)
+            == false) {
+        return false;
+    }
+    build_edit_dict(data->dicts);
+    return true;
+}
+
+/* read_dictionary()
+* −−−−−−−−−−−−−−−
+* Loads the dictionary of the game on stdin
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if unreadable or non-existent
+*/
+void read_dictionary(Data* data) {
+    if (data->dictSet == false) {
+        data->dict = DEF_DICT;
+    }
+    if (load_game_dictionary(data) == false) {
+        fprintf(stderr, FILE_NOT_OPENING, data->dict);
+        my_exit(FILE_ERROR_CODE, data);
+    }
+}
+
+/* load_worker()
+* −−−−−−−−−−−−−−−
+* Thread loading the dictionary of the game on stdin
+*
+* arg: Data of the game waiting for the dictionary
+*
+* Returns: NULL
+*/
+void* load_worker(void* arg) {
+    Data* data = arg;
+    data->loaded = load_game_dictionary(data);
+    return NULL;
+}
+
+/* start_loading()
+* −−−−−−−−−−−−−−−
+* Starts loading the dictionary of the game on stdin in the background,
+* so the game can be shown while it loads. The file is opened here first
+* so an unreadable one is still reported before the game.
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if unreadable or non-existent
+*/
+void start_loading(Data* data) {
+    if (data->dictSet == false) {
+        data->dict = DEF_DICT;
+    }
+    int file = default_embedded(data) ? 0 : open(data->dict, O_RDONLY);
+    if (file == -1) {
+        fprintf(stderr, FILE_NOT_OPENING, data->dict);
+        my_exit(FILE_ERROR_CODE, data);
+    } else if (default_embedded(data) == false) {
+        close(file);
+    }
+    data->loading = pthread_create(&data->loader, NULL, load_worker, data)
+            == 0;
+    if (data->loading == false) {
+        load_worker(data);
+    }
+}
+
+/* print_stdout()
+* −−−−−−−−−−−−−−−
+* Prints message to stdout
+*
+* message: Output message
+*
+* Returns: Nothing
+*/
+void print_stdout(const char* message) {
+    fprintf(stdout, "%s\n", message);
+}
+
+/* print_message()
+* −−−−−−−−−−−−−−−
+* Prints message to the player of the game
+*
+* game: game being played
+* message: Output message
+*
+* Returns: Nothing
+*/
+void print_message(const Game* game, const char* message) {
+    fprintf(game->out, "%s\n", message);
+}
+
+/* in_dict()
+* −−−−−−−−−−−−−−−
+* Check if the given word is in the dictionary
+*
+* word: given word to check
+* dict: dictionary of the game's word length
+*
+* Returns: boolean if word in dictionary
+*/
+bool in_dict(const char* word, const Dict* dict) {
+    return dict_lookup(word, dict) != EMPTY_SLOT;
+}
+
+/* previous_word()
+* −−−−−−−−−−−−−−−
+* Check if the given word was a previous word entered
+*
+* game: game being played
+* index: dictionary index of the word to check
+*
+* Returns: boolean if word was previous word
+*/
+bool previous_word(const Game* game, int index) {
+    return (game->visited[index / CHAR_BIT] & (1 << (index % CHAR_BIT))) != 0;
+}
+
+/* last_word()
+* −−−−−−−−−−−−−−−
+* Finds the word the next move has to be one letter away from
+*
+* game: game being played
+*
+* Returns: last word given or the initial word before any are given
+*/
+const char* last_word(const Game* game) {
+    //-2 cause attempt starts at 1
+    return game->attempt == 1 ? game->initWord
+            : game->givenWords[game->attempt - 2];
+}
+
+/* one_letter_diff()
+* −−−−−−−−−−−−−−−
+* Check if the given words are only 1 letter different. The length is only
+* worked out once and the loop stops at the second difference, which for
+* words of at most MAX_LENGTH letters beats any vector compare.
+*
+* word1: given word to check
+* word2: given word to check against, at least as long as word1
+*
+* Returns: boolean the 2 words are only 1 letter different
+*/
+bool one_letter_diff(const char* word1, const char* word2) {
+    size_t length = strlen(word1);
+    int diff = 0;
+    for (size_t i = 0; i < length && diff < 2; i++) {
+        if (word1[i] != word2[i]) {
+            diff++;
+        }
+    }
+    return diff == 1;
+}
+
+/* one_step()
+* −−−−−−−−−−−−−−−
+* Check if one move of the game takes one word to the other: a letter
+* substituted, or for the dictionary of any length also a letter inserted
+* or deleted
+*
+* game: game being played
+* word1: given word to check
+* word2: given word to check against
+*
+* Returns: boolean if word2 is one move from word1
+*/
+bool one_step(const Game* game, const char* word1, const char* word2) {
+    size_t length1 = strlen(word1);
+    size_t length2 = strlen(word2);
+    if (length1 == length2) {
+        return one_letter_diff(word1, word2);
+    }
+    if (game->dict->wordLen != ANY_LENGTH || length1 + 1 < length2
+            || length2 + 1 < length1) {
+        return false;
+    }
+    const char* shorter = length1 < length2 ? word1 : word2;
+    const char* longer = length1 < length2 ? word2 : word1;
+    size_t i = 0;
+    while (shorter[i] != '\0' && shorter[i] == longer[i]) {
+        i++;
+    }
+    //the rest matches once the extra letter is skipped
+    return strcmp(shorter + i, longer + i + 1) == 0;
+}
+
+/* One direction of the bidirectional ladder search */
+typedef struct {
+    int* dist; //steps from the root of this search, -1 if not reached
+    int* parent; //previous word on the way back to the root
+    int* queue; //words in the order they were reached
+    int head; //start of the current frontier in queue
+    int tail; //end of the current frontier in queue
+    int depth; //steps from the root to the current frontier
+} Search;
+
+/* probe_edits()
+* −−−−−−−−−−−−−−−
+* Finds the dictionary words the given word becomes with one letter deleted
+* or inserted. Deleting from, or inserting next to, the same run of a
+* letter is only tried once, so no word is found twice.
+*
+* word: given word to find neighbours of
+* dict: dictionary of any length
+* neighbours: filled with the indexes of the words found
+*
+* Returns: number of words found
+*/
+int probe_edits(const char* word, const Dict* dict, int* neighbours) {
+    int count = 0;
+    unsigned int length = strlen(word);
+    char probe[MAX_LENGTH + 2];
+    for (unsigned int p = 0; p < length; p++) {
+        if (p == 0 || word[p] != word[p - 1]) {
+            memcpy(probe, word, p);
+            strcpy(probe + p, word + p + 1);
+            int found = dict_lookup(probe, dict);
+            if (found != EMPTY_SLOT) {
+                neighbours[count++] = found;
+            }
+        }
+    }
+    for (unsigned int p = 0; p <= length && length < MAX_LENGTH; p++) {
+        memcpy(probe, word, p);
+        strcpy(probe + p + 1, word + p);
+        for (char letter = 'A'; letter <= 'Z'; letter++) {
+            if (p == 0 || letter != word[p - 1]) {
+                probe[p] = letter;
+                int found = dict_lookup(probe, dict);
+                if (found != EMPTY_SLOT) {
+                    neighbours[count++] = found;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+/* get_neighbours()
+* −−−−−−−−−−−−−−−
+* Finds the dictionary words one move away from the given word, in
+* dictionary order. Dictionary words read their row of the neighbour graph,
+* other words (e.g. an initial word not in the dictionary) are probed.
+*
+* word: given word to find neighbours of
+* dict: dictionary of one word length
+* neighbours: filled with the indexes of the neighbouring words
+*
+* Returns: number of neighbours found
+*/
+int get_neighbours(const char* word, const Dict* dict,
+        int neighbours[MAX_NEIGHBOURS]) {
+    int index = dict_lookup(word, dict);
+    if (index != EMPTY_SLOT) {
+        int count = dict->neighStart[index + 1] - dict->neighStart[index];
+        memcpy(neighbours, dict->neighbours + dict->neighStart[index],
+                sizeof(int) * count);
+        return count;
+    }
+    int count = 0;
+    unsigned int length = strlen(word);
+    char probe[MAX_LENGTH + 2];
+    strcpy(probe, word);
+    for (unsigned int p = 0; p < length; p++) {
+        for (char letter = 'A'; letter <= 'Z'; letter++) {
+            if (letter != word[p]) {
+                probe[p] = letter;
+                int found = dict_lookup(probe, dict);
+                if (found != EMPTY_SLOT) {
+                    neighbours[count++] = found;
+                }
+            }
+        }
+        probe[p] = word[p];
+    }
+    if (dict->wordLen == ANY_LENGTH) {
+        count += probe_edits(word, dict, neighbours + count);
+    }
+    qsort(neighbours, count, sizeof(int), compare_ints);
+    return count;
+}
+
+/* mark_visited()
+* −−−−−−−−−−−−−−−
+* Records a dictionary word as given, so it can't be returned to
+*
+* game: game being played
+* index: dictionary index of the word given
+*
+* Returns: Nothing
+*/
+void mark_visited(Game* game, int index) {
+    game->visited[index / CHAR_BIT] |= 1 << (index % CHAR_BIT);
+}
+
+/* target_distances()
+* −−−−−−−−−−−−−−−
+* Gets the game's distance table, filling it the first time with a breadth
+* first search back from the target that goes no further than the step
+* limit. After that, hints and checks on how far the target is take a
+* single lookup. Games with no moves or hints never pay for the search.
+*
+* game: game with its words picked
+*
+* Returns: steps from each word to the target, or UNREACHED
+*/
+const unsigned char* target_distances(Game* game) {
+    if (game->distance != NULL) {
+        return game->distance;
+    }
+    const Dict* dict = game->dict;
+    game->distance = arena_alloc(&game->arena, dict->wordsInDict + 1);
+    memset(game->distance, UNREACHED, dict->wordsInDict + 1);
+    int target = dict_lookup(game->toWord, dict);
+    if (target == EMPTY_SLOT) {
+        return game->distance;
+    }
+    int* queue = arena_alloc(&game->arena, sizeof(int) * dict->wordsInDict);
+    int head = 0;
+    int tail = 0;
+    game->distance[target] = 0;
+    queue[tail++] = target;
+    while (head < tail) {
+        int word = queue[head++];
+        if (game->distance[word] == game->stepLim) {
+            continue;
+        }
+        for (int n = dict->neighStart[word]; n < dict->neighStart[word + 1];
+                n++) {
+            int next = dict->neighbours[n];
+            if (game->distance[next] == UNREACHED) {
+                game->distance[next] = game->distance[word] + 1;
+                queue[tail++] = next;
+            }
+        }
+    }
+    return game->distance;
+}
+
+/* build_suggestions()
+* −−−−−−−−−−−−−−−
+* Works out all vaild attempts user can make, ranked by how many steps they
+* are from the target, and writes the lines to print into the game's
+* arena, so they can be printed again without working them out
+*
+* game: game being played
+* previous: given word to check against
+*
+* Returns: Nothing
+*/
+void build_suggestions(Game* game, const char* previous) {
+    const Dict* dict = game->dict;
+    const unsigned char* distance = target_distances(game);
+    //words that can't be suggested: previous words, initial and target
+    int initIndex = dict_lookup(game->initWord, dict);
+    int toIndex = dict_lookup(game->toWord, dict);
+    int neighbours[MAX_NEIGHBOURS];
+    int count = get_neighbours(previous, dict, neighbours);
+    int found = 0;
+    for (int i = 0; i < count; i++) {
+        int index = neighbours[i];
+        if (index == initIndex || index == toIndex
+                || previous_word(game, index) == true) {
+            continue;
+        }
+        //closest to the target first, ties stay in dictionary order
+        int place = found++;
+        while (place > 0 && distance[neighbours[place - 1]]
+                > distance[index]) {
+            neighbours[place] = neighbours[place - 1];
+            place--;
+        }
+        neighbours[place] = index;
+    }
+    //Check if given word is final word
+    bool toNext = one_step(game, previous, game->toWord);
+    if (stats.enabled == true) {
+        stats.candidates += count;
+        stats.suggested += found + toNext;
+    }
+    //each word line is a space, the word and a newline
+    char* line = arena_alloc(&game->arena, sizeof(SUGGEST_HEAD)
+            + sizeof(SUGGEST_TAIL) + (found + 1) * (MAX_LENGTH + 2));
+    game->suggestions = line;
+    if (toNext == false && found == 0) {
+        line = stpcpy(line, NO_SUGGESTIONS);
+    } else {
+        line = stpcpy(line, SUGGEST_HEAD);
+        if (toNext == true) {
+            line += sprintf(line, " %s\n", game->toWord);
+        }
+        for (int i = 0; i < found; i++) {
+            *line++ = ' ';
+            line += strlen(dict_word(dict, neighbours[i], line));
+            *line++ = '\n';
+        }
+        line = stpcpy(line, SUGGEST_TAIL);
+    }
+    game->suggestionsSize = line - game->suggestions;
+    strcpy(game->suggestedFor, previous);
+}
+
+/* print_suggestions()
+* −−−−−−−−−−−−−−−
+* Prints all vaild attempts user can make or no suggestions available, in
+* one write. Every accepted move changes the previous word and a previous
+* word can't come back, so the last suggestions stay right for as long as
+* the previous word is unchanged and are reused until then.
+*
+* game: game being played
+* previous: given word to check against
+*
+* Returns: Nothing
+*/
+void print_suggestions(Game* game, const char* previous) {
+    long long start = stats.enabled ? stats_now() : 0;
+    if (strcmp(previous, game->suggestedFor) != 0) {
+        build_suggestions(game, previous);
+    } else if (stats.enabled == true) {
+        stats.suggestionHits++;
+    }
+    fwrite(game->suggestions, 1, game->suggestionsSize, game->out);
+    if (stats.enabled == true) {
+        stats_record(&stats.suggestions, start);
+    }
+}
+
+/* search_init()
+* −−−−−−−−−−−−−−−
+* Allocates one direction of the ladder search rooted at the given word
+*
+* arena: arena the search arrays come from
+* nodes: number of words the search can reach
+* root: index of the word the search starts from
+*
+* Returns: search with only the root reached
+*/
+Search search_init(Arena* arena, int nodes, int root) {
+    Search search;
+    search.dist = arena_alloc(arena, sizeof(int) * nodes);
+    memset(search.dist, 0xff, sizeof(int) * nodes);
+    search.parent = arena_alloc(arena, sizeof(int) * nodes);
+    search.queue = arena_alloc(arena, sizeof(int) * nodes);
+    search.dist[root] = 0;
+    search.parent[root] = EMPTY_SLOT;
+    search.queue[0] = root;
+    search.head = 0;
+    search.tail = 1;
+    search.depth = 0;
+    return search;
+}
+
+/* search_level()
+* −−−−−−−−−−−−−−−
+* Expands the whole current frontier of one search by a step, recording the
+* shortest join with the other search. Node wordsInDict stands for an
+* initial word that is not in the dictionary.
+*
+* search: search being expanded
+* other: search from the opposite end of the ladder
+* game: game being solved
+* best: shortest ladder length found so far, updated on a shorter join
+* join: words either side of the best join, in search then other order
+*
+* Returns: Nothing
+*/
+void search_level(Search* search, Search* other, const Game* game,
+        int* best, int join[2]) {
+    const Dict* dict = game->dict;
+    int end = search->tail;
+    int buffer[MAX_NEIGHBOURS];
+    for (int i = search->head; i < end; i++) {
+        int word = search->queue[i];
+        const int* neighbours = buffer;
+        int count;
+        if (word == dict->wordsInDict) {
+            count = get_neighbours(game->initWord, dict, buffer);
+        } else {
+            neighbours = dict->neighbours + dict->neighStart[word];
+            count = dict->neighStart[word + 1] - dict->neighStart[word];
+        }
+        for (int n = 0; n < count; n++) {
+            int next = neighbours[n];
+            if (search->dist[next] == EMPTY_SLOT) {
+                search->dist[next] = search->depth + 1;
+                search->parent[next] = word;
+                search->queue[search->tail++] = next;
+            }
+            if (other->dist[next] != EMPTY_SLOT
+                    && search->depth + 1 + other->dist[next] < *best) {
+                *best = search->depth + 1 + other->dist[next];
+                join[0] = word;
+                join[1] = next;
+            }
+        }
+    }
+    search->head = end;
+    search->depth++;
+}
+
+/* print_ladder()
+* −−−−−−−−−−−−−−−
+* Prints the ladder found by joining the forward and backward searches
+*
+* forward: search rooted at the initial word
+* backward: search rooted at the target word
+* game: game being solved
+* steps: length of the ladder
+* join: last word reached forwards and first word reached backwards
+*
+* Returns: Nothing
+*/
+void print_ladder(Search forward, Search backward, Game* game,
+        int steps, int join[2]) {
+    int* ladder = arena_alloc(&game->arena, sizeof(int) * (steps + 1));
+    int position = forward.dist[join[0]];
+    for (int word = join[0]; word != EMPTY_SLOT;
+            word = forward.parent[word]) {
+        ladder[position--] = word;
+    }
+    position = forward.dist[join[0]] + 1;
+    for (int word = join[1]; word != EMPTY_SLOT;
+            word = backward.parent[word]) {
+        ladder[position++] = word;
+    }
+    fprintf(stdout, SOLUTION, game->initWord, game->toWord, steps);
+    char word[MAX_LENGTH + 1];
+    for (int i = 0; i <= steps; i++) {
+        print_stdout(ladder[i] == game->dict->wordsInDict
+                ? game->initWord : dict_word(game->dict, ladder[i], word));
+    }
+}
+
+/* solve_ladder()
+* −−−−−−−−−−−−−−−
+* Finds the shortest ladder from the initial to the target word with a
+* bidirectional breadth first search over word indexes, always growing the
+* smaller frontier. The search arrays come from the game's arena.
+*
+* game: game being solved
+*
+* Returns: exit code, NO_LADDER_CODE if no ladder fits the step limit
+*/
+int solve_ladder(Game* game) {
+    const Dict* dict = game->dict;
+    int start = dict_lookup(game->initWord, dict);
+    int target = dict_lookup(game->toWord, dict);
+    int best = INT_MAX;
+    int join[2];
+    if (target != EMPTY_SLOT) {
+        //one extra node for an initial word outside the dictionary
+        int nodes = dict->wordsInDict + 1;
+        Search forward = search_init(&game->arena, nodes,
+                start == EMPTY_SLOT ? dict->wordsInDict : start);
+        Search backward = search_init(&game->arena, nodes, target);
+        while (best == INT_MAX && forward.head < forward.tail
+                && backward.head < backward.tail
+                && forward.depth + backward.depth < (int)game->stepLim) {
+            if (forward.tail - forward.head
+                    <= backward.tail - backward.head) {
+                search_level(&forward, &backward, game, &best, join);
+            } else {
+                search_level(&backward, &forward, game, &best, join);
+                int swap = join[0];
+                join[0] = join[1];
+                join[1] = swap;
+            }
+        }
+        if (best != INT_MAX) {
+            print_ladder(forward, backward, game, best, join);
+        }
+    }
+    if (best == INT_MAX) {
+        fprintf(stdout, NO_SOLUTION, game->initWord, game->toWord,
+                game->stepLim);
+        return NO_LADDER_CODE;
+    }
+    return 0;
+}
+
+/*Walk through the shortest ladders of a game one at a time, in dictionary
+order. Only the current ladder and a place in each of its words' rows are
+kept, so any number of ladders can be walked.*/
+typedef struct {
+    const Dict* dict; //dictionary of the game
+    const unsigned char* distance; //steps from each word to the target
+    int steps; //length of every shortest ladder
+    const int* first; //neighbours of the initial word
+    int firstCount; //number of neighbours of the initial word
+    int ladder[MAX_STEP + 1]; //words after the initial word, from 1
+    int place[MAX_STEP + 1]; //place reached in the row of each word before
+    int depth; //word of the ladder being chosen, 0 once all are walked
+} Ladders;
+
+/* ladders_next()
+* −−−−−−−−−−−−−−−
+* Moves on to the next shortest ladder. A word can follow the one before
+* it only if it is one step closer to the target, so every branch taken
+* ends at the target and nothing has to be undone.
+*
+* ladders: walk through the ladders, depth 1 and place 1 zero to start
+*
+* Returns: boolean if there was another ladder, left in ladders->ladder
+*/
+bool ladders_next(Ladders* ladders) {
+    const Dict* dict = ladders->dict;
+    while (ladders->depth > 0) {
+        int depth = ladders->depth;
+        const int* row = ladders->first;
+        int count = ladders->firstCount;
+        if (depth > 1) {
+            int word = ladders->ladder[depth - 1];
+            row = dict->neighbours + dict->neighStart[word];
+            count = dict->neighStart[word + 1] - dict->neighStart[word];
+        }
+        int* place = &ladders->place[depth];
+        while (*place < count && ladders->distance[row[*place]]
+                != ladders->steps - depth) {
+            (*place)++;
+        }
+        if (*place == count) {
+            //this word's row is used up, so the word before moves on
+            ladders->depth--;
+            continue;
+        }
+        ladders->ladder[depth] = row[(*place)++];
+        if (depth == ladders->steps) {
+            return true;
+        }
+        ladders->depth++;
+        ladders->place[depth + 1] = 0;
+    }
+    return false;
+}
+
+/* count_ladders()
+* −−−−−−−−−−−−−−−
+* Counts the shortest ladders of the game without listing them, by
+* dynamic programming over the layers of a breadth first search from the
+* initial word. The search only follows words one step closer to the
+* target, so each layer holds words the same number of steps from both
+* ends, and the ladders reaching a word are the sum of those reaching the
+* words before it. Counts saturate instead of overflowing. The first
+* shown ladders are then printed, one per line.
+*
+* game: game with its words picked
+* shown: most ladders to print
+*
+* Returns: 0 if a ladder exists within the step limit or NO_LADDER_CODE
+*/
+int count_ladders(Game* game, unsigned int shown) {
+    const Dict* dict = game->dict;
+    const unsigned char* distance = target_distances(game);
+    int target = dict_lookup(game->toWord, dict);
+    Ladders ladders;
+    ladders.dict = dict;
+    ladders.distance = distance;
+    //the initial word may be outside the dictionary, so only its row is used
+    int first[MAX_NEIGHBOURS];
+    ladders.first = first;
+    ladders.firstCount = get_neighbours(game->initWord, dict, first);
+    ladders.steps = UNREACHED;
+    for (int i = 0; i < ladders.firstCount; i++) {
+        if (distance[first[i]] + 1 < ladders.steps) {
+            ladders.steps = distance[first[i]] + 1;
+        }
+    }
+    if (ladders.steps > (int)game->stepLim) {
+        fprintf(stdout, NO_SOLUTION, game->initWord, game->toWord,
+                game->stepLim);
+        return NO_LADDER_CODE;
+    }
+    uint64_t* ways = arena_alloc(&game->arena,
+            sizeof(uint64_t) * dict->wordsInDict);
+    memset(ways, 0, sizeof(uint64_t) * dict->wordsInDict);
+    int* queue = arena_alloc(&game->arena, sizeof(int) * dict->wordsInDict);
+    int head = 0;
+    int tail = 0;
+    for (int i = 0; i < ladders.firstCount; i++) {
+        if (distance[first[i]] == ladders.steps - 1) {
+            ways[first[i]] = 1;
+            queue[tail++] = first[i];
+        }
+    }
+    //a word's count is complete before its layer is reached
+    while (head < tail) {
+        int word = queue[head++];
+        for (int n = dict->neighStart[word]; n < dict->neighStart[word + 1];
+                n++) {
+            int next = dict->neighbours[n];
+            if (distance[next] + 1 != distance[word]) {
+                continue;
+            }
+            if (ways[next] == 0) {
+                queue[tail++] = next;
+            }
+            ways[next] = ways[next] > UINT64_MAX - ways[word] ? UINT64_MAX
+                    : ways[next] + ways[word];
+        }
+    }
+    fprintf(stdout, LADDER_COUNT, ways[target] == UINT64_MAX ? "at least "
+            : "", (unsigned long long)ways[target], game->initWord,
+            game->toWord, ladders.steps);
+    ladders.depth = 1;
+    ladders.place[1] = 0;
+    char word[MAX_LENGTH + 1];
+    for (unsigned int i = 0; i < shown && ladders_next(&ladders); i++) {
+        fprintf(stdout, "%s", game->initWord);
+        for (int step = 1; step <= ladders.steps; step++) {
+            fprintf(stdout, " %s", dict_word(dict, ladders.ladder[step],
+                    word));
+        }
+        fprintf(stdout, "\n");
+    }
+    return 0;
+}
+
+/*Ladder statistics of one dictionary, shared by the analysis threads*/
+typedef struct {
+    const Dict* dict; //dictionary being analysed
+    int nextSource; //first word no thread has taken a search from yet
+    int* eccentricity; //steps to the furthest word reachable from each word
+    long long* histogram; //number of word pairs each number of steps apart
+    long long unreachable; //number of word pairs with no ladder
+    int diameter; //longest shortest ladder
+    int diameterFrom; //one end of a longest shortest ladder
+    int diameterTo; //other end of a longest shortest ladder
+    pthread_mutex_t lock; //guards the totals while a thread adds to them
+} Analysis;
+
+/* analyze_worker()
+* −−−−−−−−−−−−−−−
+* Thread of the analysis. It takes ANALYZE_CHUNK words at a time until none
+* are left and runs a breadth first search from each, counting each pair
+* of words once from its lower index. Threads that finish their chunks
+* early just take more, so the work stays balanced. Distances and counts
+* are kept per thread and added to the totals once at the end.
+*
+* arg: shared Analysis
+*
+* Returns: NULL
+*/
+void* analyze_worker(void* arg) {
+    Analysis* analysis = arg;
+    const Dict* dict = analysis->dict;
+    int words = dict->wordsInDict;
+    int* dist = stats_malloc(sizeof(int) * words);
+    memset(dist, 0xff, sizeof(int) * words);
+    int* queue = stats_malloc(sizeof(int) * words);
+    long long* histogram = stats_calloc(words, sizeof(long long));
+    long long unreachable = 0;
+    int diameter = 0;
+    int diameterFrom = 0;
+    int diameterTo = 0;
+    int first;
+    while ((first = __atomic_fetch_add(&analysis->nextSource, ANALYZE_CHUNK,
+            __ATOMIC_RELAXED)) < words) {
+        int last = first + ANALYZE_CHUNK < words ? first + ANALYZE_CHUNK
+                : words;
+        for (int source = first; source < last; source++) {
+            int head = 0;
+            int tail = 0;
+            int reachedAbove = 0;
+            dist[source] = 0;
+            queue[tail++] = source;
+            while (head < tail) {
+                int word = queue[head++];
+                for (int n = dict->neighStart[word];
+                        n < dict->neighStart[word + 1]; n++) {
+                    int next = dict->neighbours[n];
+                    if (dist[next] == EMPTY_SLOT) {
+                        dist[next] = dist[word] + 1;
+                        queue[tail++] = next;
+                    }
+                }
+                if (word > source) {
+                    histogram[dist[word]]++;
+                    reachedAbove++;
+                }
+            }
+            //the queue is in distance order so its last word is furthest
+            int furthest = queue[tail - 1];
+            analysis->eccentricity[source] = dist[furthest];
+            if (dist[furthest] > diameter) {
+                diameter = dist[furthest];
+                diameterFrom = source;
+                diameterTo = furthest;
+            }
+            unreachable += words - 1 - source - reachedAbove;
+            for (int i = 0; i < tail; i++) {
+                dist[queue[i]] = EMPTY_SLOT;
+            }
+        }
+    }
+    pthread_mutex_lock(&analysis->lock);
+    for (int steps = 1; steps < words; steps++) {
+        analysis->histogram[steps] += histogram[steps];
+    }
+    analysis->unreachable += unreachable;
+    //ties go to the lowest word so the result doesn't depend on threads
+    if (diameter > analysis->diameter || (diameter == analysis->diameter
+            && diameterFrom < analysis->diameterFrom)) {
+        analysis->diameter = diameter;
+        analysis->diameterFrom = diameterFrom;
+        analysis->diameterTo = diameterTo;
+    }
+    pthread_mutex_unlock(&analysis->lock);
+    free(dist);
+    free(queue);
+    free(histogram);
+    return NULL;
+}
+
+/* analyze_dict()
+* −−−−−−−−−−−−−−−
+* Prints the ladder statistics of one dictionary: its diameter, how many
+* word pairs are each number of steps apart and the eccentricity of every
+* word, found with a breadth first search from every word spread over one
+* thread per processor
+*
+* dict: dictionary to analyse
+*
+* Returns: Nothing
+*/
+void analyze_dict(const Dict* dict) {
+    int words = dict->wordsInDict;
+    char from[MAX_LENGTH + 1];
+    char to[MAX_LENGTH + 1];
+    Analysis analysis;
+    memset(&analysis, 0, sizeof(analysis));
+    analysis.dict = dict;
+    analysis.eccentricity = stats_malloc(sizeof(int) * (words + 1));
+    analysis.histogram = stats_calloc(words + 1, sizeof(long long));
+    pthread_mutex_init(&analysis.lock, NULL);
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    int threadCount = processors > 0 ? processors : 1;
+    pthread_t* threads = stats_malloc(sizeof(pthread_t) * threadCount);
+    //workers take sources until none are left, so any number of them
+    //finish the search, this thread alone if none could be started
+    int started = 0;
+    for (int i = 0; i < threadCount; i++) {
+        if (pthread_create(&threads[started], NULL, analyze_worker,
+                &analysis) == 0) {
+            started++;
+        }
+    }
+    if (started == 0) {
+        analyze_worker(&analysis);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    fprintf(stdout, ANALYZE_SUMMARY, dict->wordLen, words,
+            dict->neighStart[words] / 2);
+    if (analysis.diameter > 0) {
+        fprintf(stdout, ANALYZE_DIAMETER, analysis.diameter,
+                dict_word(dict, analysis.diameterFrom, from),
+                dict_word(dict, analysis.diameterTo, to));
+    }
+    print_stdout("Steps\tPairs");
+    for (int steps = 1; steps <= analysis.diameter; steps++) {
+        fprintf(stdout, "%d\t%lld\n", steps, analysis.histogram[steps]);
+    }
+    fprintf(stdout, "none\t%lld\n", analysis.unreachable);
+    print_stdout("Word\tEccentricity");
+    for (int i = 0; i < words; i++) {
+        fprintf(stdout, "%s\t%d\n", dict_word(dict, i, from),
+                analysis.eccentricity[i]);
+    }
+    pthread_mutex_destroy(&analysis.lock);
+    free(threads);
+    free(analysis.eccentricity);
+    free(analysis.histogram);
+}
+
+/* run_analysis()
+* −−−−−−−−−−−−−−−
+* Prints the ladder statistics of the dictionary for the given word length,
+* or for every word length if none is given
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if other game options are given,
+* the word length is out of range or the dictionary can't be read
+*/
+void run_analysis(Data* data) {
+    if (data->initWordSet || data->toWordSet || data->stepLimSet
+            || data->solve || data->edit || data->count || data->embed) {
+        error_exit(USAGE_ERROR, USAGE_ERROR_CODE, data);
+    }
+    if (data->wordLenSet == true && (data->wordLen < MIN_LENGTH
+            || data->wordLen > MAX_LENGTH)) {
+        error_exit(WORD_LEN_ERROR, WORD_LEN_ERROR_CODE, data);
+    }
+    if (data->dictSet == false) {
+        data->dict = DEF_DICT;
+    }
+    setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER);
+    unsigned int first = data->wordLenSet ? data->wordLen : MIN_LENGTH;
+    unsigned int last = data->wordLenSet ? data->wordLen : MAX_LENGTH;
+    if (load_words(data, data->dicts, first, last, true) == false) {
+        fprintf(stderr, FILE_NOT_OPENING, data->dict);
+        my_exit(FILE_ERROR_CODE, data);
+    }
+    for (unsigned int length = first; length <= last; length++) {
+        analyze_dict(&data->dicts[length]);
+    }
+    my_exit(0, data);
+}
+
+/* find_starts()
+* −−−−−−−−−−−−−−−
+* Lists the words random puzzles can start from, those with at least one
+* neighbour, as no ladder leads anywhere from an isolated word
+*
+* dict: dictionary of one word length
+*
+* Returns: Nothing
+*/
+void find_starts(Dict* dict) {
+    dict->startCount = 0;
+    for (int i = 0; i < dict->wordsInDict; i++) {
+        if (dict->neighStart[i + 1] > dict->neighStart[i]) {
+            dict->startCount++;
+        }
+    }
+    dict->starts = arena_alloc(&dict->arena,
+            sizeof(int) * (dict->startCount + 1));
+    int start = 0;
+    for (int i = 0; i < dict->wordsInDict; i++) {
+        if (dict->neighStart[i + 1] > dict->neighStart[i]) {
+            dict->starts[start++] = i;
+        }
+    }
+}
+
+/* random_start()
+* −−−−−−−−−−−−−−−
+* Picks a random dictionary word that has at least one neighbour, from the
+* list made by find_starts()
+*
+* dict: dictionary of one word length, with its start words found
+*
+* Returns: index of the word or EMPTY_SLOT if every word is isolated
+*/
+int random_start(const Dict* dict) {
+    if (dict->startCount == 0) {
+        return EMPTY_SLOT;
+    }
+    return dict->starts[rand() % dict->startCount];
+}
+
+/* random_walk()
+* −−−−−−−−−−−−−−−
+* Walks randomly through the neighbour graph without revisiting words. The
+* word reached is at most steps away from the start, so the ladder between
+* them always fits the step limit.
+*
+* start: word the walk begins at, need not be in the dictionary
+* steps: most steps to take
+* length: length the word reached must have, or ANY_LENGTH for any
+* dict: dictionary of one word length
+*
+* Returns: index of the last word reached of that length or EMPTY_SLOT if
+* none was
+*/
+int random_walk(const char* start, unsigned int steps, unsigned int length,
+        const Dict* dict) {
+    int walk[MAX_STEP + 1];
+    int walked = 0;
+    int neighbours[MAX_NEIGHBOURS];
+    int count = get_neighbours(start, dict, neighbours);
+    walk[walked++] = dict_lookup(start, dict);
+    while ((unsigned int)walked <= steps && count > 0) {
+        //drops neighbours already on the walk then steps to a random one
+        int fresh = 0;
+        for (int n = 0; n < count; n++) {
+            bool seen = false;
+            for (int w = 0; w < walked; w++) {
+                seen = seen || walk[w] == neighbours[n];
+            }
+            if (!seen) {
+                neighbours[fresh++] = neighbours[n];
+            }
+        }
+        if (fresh == 0) {
+            break;
+        }
+        int next = neighbours[rand() % fresh];
+        walk[walked++] = next;
+        count = dict->neighStart[next + 1] - dict->neighStart[next];
+        memcpy(neighbours, dict->neighbours + dict->neighStart[next],
+                sizeof(int) * count);
+    }
+    //with --edit the walk may pass through words of every length
+    for (int w = walked - 1; w > 0; w--) {
+        char word[MAX_LENGTH + 1];
+        if (length == ANY_LENGTH || dict->wordLen == length
+                || strlen(dict_word(dict, walk[w], word)) == length) {
+            return walk[w];
+        }
+    }
+    return EMPTY_SLOT;
+}
+
+/* pick_words()
+* −−−−−−−−−−−−−−−
+* Picks any initial or target word not given (left empty) so that a ladder
+* between them exists within the step limit. The dictionary's start words
+* must already be found.
+*
+* game: game to pick the words of
+* initLen: length a picked initial word must have, which only matters with
+* --edit as every other dictionary has one length
+*
+* Returns: boolean if a solvable ladder could be made
+*/
+bool pick_words(Game* game, unsigned int initLen) {
+    const Dict* dict = game->dict;
+    bool initGiven = game->initWord[0] != '\0';
+    bool toGiven = game->toWord[0] != '\0';
+    if (initGiven == true && toGiven == true) {
+        return true;
+    }
+    if (initGiven == false && toGiven == false) {
+        int start = random_start(dict);
+        if (start == EMPTY_SLOT) {
+            return false;
+        }
+        dict_word(dict, start, game->initWord);
+    } else if (toGiven == true && in_dict(game->toWord, dict) == false) {
+        //the target can't be entered so no ladder reaches it
+        return false;
+    }
+    //ladders are reversible so a walk from either end works
+    bool fromInit = toGiven == false;
+    int end = EMPTY_SLOT;
+    for (int walk = 0; walk < MAX_WALKS && end == EMPTY_SLOT; walk++) {
+        end = random_walk(fromInit ? game->initWord : game->toWord,
+                game->stepLim, fromInit ? ANY_LENGTH : initLen, dict);
+    }
+    if (end == EMPTY_SLOT) {
+        return false;
+    }
+    dict_word(dict, end, fromInit ? game->toWord : game->initWord);
+    return true;
+}
+
+/* game_init()
+* −−−−−−−−−−−−−−−
+* Starts a game with no words picked or given yet. Its visited bitset and
+* distance table come from its arena, which is reset here, so a game
+* reused for game after game stops touching the heap.
+*
+* game: game to start
+* dict: shared dictionary of the game's word length
+* stepLim: step limit
+* out: where game messages are printed
+*
+* Returns: Nothing
+*/
+void game_init(Game* game, const Dict* dict, unsigned int stepLim,
+        FILE* out) {
+    game->dict = dict;
+    game->initWord[0] = '\0';
+    game->toWord[0] = '\0';
+    game->stepLim = stepLim;
+    game->attempt = 1;
+    arena_reset(&game->arena);
+    game->visited = arena_alloc(&game->arena, dict->wordsInDict / CHAR_BIT
+            + 1);
+    memset(game->visited, 0, dict->wordsInDict / CHAR_BIT + 1);
+    game->distance = NULL;
+    game->stranded = false;
+    game->suggestedFor[0] = '\0';
+    game->suggestions = NULL;
+    game->out = out;
+    game->result = GAME_PLAYING;
+}
+
+/* generate_words()
+* −−−−−−−−−−−−−−−
+* Starts the game on stdin, picking any initial or target word not given
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if no solvable ladder can be made
+*/
+void generate_words(Data* data) {
+    Game* game = &data->game;
+    game_init(game, &data->dicts[data->edit ? ANY_LENGTH : data->wordLen],
+            data->stepLim, stdout);
+    if (data->initWordSet == true) {
+        strcpy(game->initWord, data->initWord);
+    }
+    if (data->toWordSet == true) {
+        strcpy(game->toWord, data->toWord);
+    }
+    if (data->initWordSet == false && data->toWordSet == false) {
+        Dict* starts = &data->dicts[data->wordLen];
+        find_starts(starts);
+        //a random initial word has the chosen length even with --edit
+        if (data->edit == true) {
+            int start = random_start(starts);
+            if (start == EMPTY_SLOT) {
+                error_exit(NO_PUZZLE, NO_PUZZLE_CODE, data);
+            }
+            dict_word(starts, start, game->initWord);
+        }
+    }
+    if (pick_words(game, data->wordLen) == false) {
+        error_exit(NO_PUZZLE, NO_PUZZLE_CODE, data);
+    }
+}
+
+/* wait_dictionary()
+* −−−−−−−−−−−−−−−
+* Waits for the background dictionary load and starts the game on stdin
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if the dictionary couldn't be read
+*/
+void wait_dictionary(Data* data) {
+    long long start = stats.enabled ? stats_now() : 0;
+    if (data->loading == true) {
+        pthread_join(data->loader, NULL);
+        data->loading = false;
+    }
+    stats.waitNs += stats.enabled ? stats_now() - start : 0;
+    if (data->loaded == false) {
+        fprintf(stderr, FILE_NOT_OPENING, data->dict);
+        my_exit(FILE_ERROR_CODE, data);
+    }
+    generate_words(data);
+}
+
+/* check_input()
+* −−−−−−−−−−−−−−−
+* Gets user input and checks if it is valid
+*
+* input: users input
+* game: game being played, result is set once the game is won or the step
+* limit is reached
+*
+* Returns: Nothing
+*/
+void check_input(const char* input, Game* game) {
+    int index = EMPTY_SLOT;
+    long long start = stats.enabled ? stats_now() : 0;
+    if (strcmp(input, "?") == 0) {
+        print_suggestions(game, last_word(game));
+        return;
+    } else if (game->dict->wordLen != ANY_LENGTH
+            && strlen(input) != game->dict->wordLen) {
+        fprintf(game->out, "Word should have %d characters - try again.\n",
+                game->dict->wordLen);
+    } else if (check_chars(input) == false) {
+        print_message(game, ONLY_LETTERS);
+    } else if (one_step(game, input, last_word(game)) == false) {
+        print_message(game, DIFFER_ONE);
+    } else if (strcmp(input, game->initWord) == 0
+            || ((index = dict_lookup(input, game->dict)) != EMPTY_SLOT
+            && previous_word(game, index) == true)) {
+        print_message(game, NO_PREVIOUS);
+    } else if (index == EMPTY_SLOT) {
+        print_message(game, NOT_IN_DICT);
+    } else if (strcmp(input, game->toWord) == 0) {
+        fprintf(game->out, "Well done - you solved the ladder in %d steps.\n",
+                game->attempt);
+        game->result = 0;
+    } else if (game->attempt == game->stepLim) {
+        print_message(game, GAME_OVER);
+        game->result = GAME_LOST_CODE;
+    } else {
+        //words fit in place, so a move allocates nothing
+        strcpy(game->givenWords[game->attempt - 1], input);
+        mark_visited(game, index);
+        game->attempt++;
+        //steps only ever use up the slack, so this is only said once
+        if (game->stranded == false && target_distances(game)[index]
+                + game->attempt - 1 > (int)game->stepLim) {
+            print_message(game, NO_FINISH);
+            game->stranded = true;
+        }
+    }
+    if (stats.enabled == true) {
+        stats_record(&stats.moves, start);
+    }
+}
+
+/* game_loop()
+* −−−−−−−−−−−−−−−
+* Gets user input and checks if it is valid
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Message prints and exits if exited 
+* REF: Used Chat-GPT to convered my function with fgets, to something with
+* REF: dynamically allocated memory. Which it gave getline.
+* REF: Which was changed to fit styleguide and comments added to show my 
+* REF: understanding of the function.
+*/
+void game_loop(Data* data) {
+    char* input = NULL; // Initialize input pointer to NULL
+    size_t inputSize = 0; // Initialize inputSize to 0
+
+    while (1) {
+        //a game still waiting for its dictionary starts on word 1
+        bool started = data->game.dict != NULL;
+        fprintf(stdout, ENTER_WORD, started ? data->game.attempt : 1);
+        if (started == false) {
+            fflush(stdout);
+        }
+        if (stats.enabled == true && stats.promptNs == 0) {
+            stats.promptNs = stats_now() - stats.startNs;
+        }
+        // getline() reads the whole line from stdin.
+        // since input is NULL and inputSize 0
+        // getline will allocate sufficent memory for input
+        if (getline(&input, &inputSize, stdin) == -1) {
             free(input); // Free the allocated memory
             print_stdout(GAVE_UP);
             my_exit(GAVE_UP_CODE, data);
         }
-        // Remove trailing newline character
-        if (input[strlen(input) - 1] == '\n') {
-            input[strlen(input) - 1] = '\0';
+        // Remove trailing newline character
+        if (input[strlen(input) - 1] == '\n') {
+            input[strlen(input) - 1] = '\0';
+        }
+        make_caps(input);
+        if (started == false) {
+            wait_dictionary(data);
+        }
+        check_input(input, &data->game);
+        if (data->game.result != GAME_PLAYING) {
+            free(input);
+            my_exit(data->game.result, data);
+        }
+    }
+    // Free dynamically allocated memory for input
+    free(input);
+}
+
+/* session_options()
+* −−−−−−−−−−−−−−−
+* Checks the game options line sent by a player. It takes the same
+* --init, --target, --max and --length options as the command line, checked
+* in the same order with the same messages.
+*
+* line: options line, split up in place
+* options: filled with the options given, words pointing into line
+*
+* Returns: error message for the options or NULL if they are valid
+*/
+const char* session_options(char* line, Data* options) {
+    char* save = NULL;
+    for (char* arg = strtok_r(line, " ", &save); arg != NULL;
+            arg = strtok_r(NULL, " ", &save)) {
+        char* value = strtok_r(NULL, " ", &save);
+        if (value == NULL) {
+            return USAGE_ERROR;
+        } else if (strcmp(arg, "--init") == 0 && !options->initWordSet) {
+            options->initWord = value;
+            options->initWordSet = true;
+        } else if (strcmp(arg, "--target") == 0 && !options->toWordSet) {
+            options->toWord = value;
+            options->toWordSet = true;
+        } else if (strcmp(arg, "--max") == 0 && !options->stepLimSet
+                && atol(value) > 0 && check_digits(value)) {
+            options->stepLim = atol(value);
+            options->stepLimSet = true;
+        } else if (strcmp(arg, "--length") == 0 && !options->wordLenSet
+                && atol(value) > 0 && check_digits(value)) {
+            options->wordLen = atol(value);
+            options->wordLenSet = true;
+        } else {
+            return USAGE_ERROR;
+        }
+    }
+    if (options->wordLenSet == false) {
+        options->wordLen = options->initWordSet == options->toWordSet
+                ? DEF_LENGTH : strlen(options->initWordSet
+                ? options->initWord : options->toWord);
+    }
+    if ((options->initWordSet && strlen(options->initWord)
+            != options->wordLen) || (options->toWordSet
+            && strlen(options->toWord) != options->wordLen)) {
+        return LENGTH_CONFLICT;
+    } else if (options->wordLen < MIN_LENGTH
+            || options->wordLen > MAX_LENGTH) {
+        return WORD_LEN_ERROR;
+    } else if ((options->initWordSet && !check_chars(options->initWord))
+            || (options->toWordSet && !check_chars(options->toWord))) {
+        return WORD_ERROR;
+    } else if (options->initWordSet && options->toWordSet
+            && strcasecmp(options->initWord, options->toWord) == 0) {
+        return WORD_SAME;
+    } else if (options->stepLimSet == false) {
+        options->stepLim = DEF_STEP;
+    } else if (options->stepLim < options->wordLen
+            || options->stepLim > MAX_STEP) {
+        return STEP_ERROR;
+    }
+    return NULL;
+}
+
+/* option_words()
+* −−−−−−−−−−−−−−−
+* Copies the words given in a game options line into a game in uppercase
+* and picks any not given
+*
+* game: game started with the options
+* options: options given for the game
+*
+* Returns: boolean if a solvable ladder could be made
+*/
+bool option_words(Game* game, const Data* options) {
+    if (options->initWordSet == true) {
+        strcpy(game->initWord, options->initWord);
+        make_caps(game->initWord);
+    }
+    if (options->toWordSet == true) {
+        strcpy(game->toWord, options->toWord);
+        make_caps(game->toWord);
+    }
+    return pick_words(game, options->wordLen);
+}
+
+/* session_start()
+* −−−−−−−−−−−−−−−
+* Sets up the game of a new player from their options line and welcomes
+* them, or tells them what is wrong with the options
+*
+* session: session of the player
+* line: options line
+* snapshot: dictionaries new games start on
+* out: where messages for the player are printed
+*
+* Returns: boolean if the game started
+*/
+bool session_start(Session* session, char* line, Snapshot* snapshot,
+        FILE* out) {
+    Data options;
+    set_false(&options);
+    const char* error = session_options(line, &options);
+    if (error != NULL) {
+        fprintf(out, "%s\n", error);
+        return false;
+    }
+    //the game shares the dictionary loaded for its length, and keeps the
+    //snapshot it is in until the game ends
+    Game* game = &session->game;
+    session->snapshot = snapshot;
+    snapshot->games++;
+    game_init(game, &snapshot->dicts[options.wordLen], options.stepLim, out);
+    if (option_words(game, &options) == false) {
+        fprintf(out, "%s\n", NO_PUZZLE);
+        return false;
+    }
+    fprintf(out, WELCOME, game->initWord, game->toWord, game->stepLim);
+    fprintf(out, ENTER_WORD, game->attempt);
+    session->started = true;
+    return true;
+}
+
+/* session_queue()
+* −−−−−−−−−−−−−−−
+* Adds bytes to the output waiting to be sent to a player. The buffer is
+* doubled when full and kept once sent, so replies stop allocating.
+*
+* session: session of the player
+* text: bytes to send
+* textLen: number of bytes in text
+*
+* Returns: Nothing
+*/
+void session_queue(Session* session, const char* text, size_t textLen) {
+    if (session->outputLen + textLen > session->outputSize) {
+        size_t size = session->outputSize == 0 ? SESSION_OUTPUT
+                : session->outputSize;
+        while (size < session->outputLen + textLen) {
+            size *= 2;
+        }
+        session->output = stats_realloc(session->output, size);
+        session->outputSize = size;
+    }
+    memcpy(session->output + session->outputLen, text, textLen);
+    session->outputLen += textLen;
+}
+
+/* session_write()
+* −−−−−−−−−−−−−−−
+* fopencookie() write function of a session's stream, queueing whatever
+* the game prints
+*
+* cookie: session of the player
+* text: bytes printed
+* textLen: number of bytes in text
+*
+* Returns: number of bytes queued, all of them
+*/
+ssize_t session_write(void* cookie, const char* text, size_t textLen) {
+    session_queue(cookie, text, textLen);
+    return textLen;
+}
+
+/* session_line()
+* −−−−−−−−−−−−−−−
+* Handles one line from a player, the options line first and then moves,
+* queueing the same messages a game on stdin would print
+*
+* session: session of the player
+* line: line sent by the player without its newline
+* snapshot: dictionaries new games start on
+*
+* Returns: Nothing
+*/
+void session_line(Session* session, char* line, Snapshot* snapshot) {
+    FILE* out = session->out;
+    if (session->started == false) {
+        session->closing = !session_start(session, line, snapshot, out);
+    } else {
+        make_caps(line);
+        check_input(line, &session->game);
+        if (session->game.result != GAME_PLAYING) {
+            session->closing = true;
+        } else {
+            fprintf(out, ENTER_WORD, session->game.attempt);
         }
-        make_caps(input);
-        data = check_input(input, data);
     }
-    // Free dynamically allocated memory for input
-    free(input);
+}
+
+/* session_read()
+* −−−−−−−−−−−−−−−
+* Reads everything the player has sent and handles each complete line
+*
+* session: session of the player
+* snapshot: dictionaries new games start on
+*
+* Returns: boolean if the connection is still open
+*/
+bool session_read(Session* session, Snapshot* snapshot) {
+    while (true) {
+        ssize_t got = read(session->fd, session->input + session->inputLen,
+                MAX_LINE - session->inputLen);
+        if (got == 0) {
+            //player gave up, anything already queued is still sent
+            if (session->started == true && session->closing == false) {
+                session_queue(session, GAVE_UP "\n", strlen(GAVE_UP "\n"));
+            }
+            session->closing = true;
+            return true;
+        } else if (got < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        session->inputLen += got;
+        char* newline;
+        while (session->closing == false && (newline = memchr(session->input,
+                '\n', session->inputLen)) != NULL) {
+            *newline = '\0';
+            session_line(session, session->input, snapshot);
+            size_t used = newline + 1 - session->input;
+            memmove(session->input, newline + 1, session->inputLen - used);
+            session->inputLen -= used;
+        }
+        if (session->closing == true) {
+            session->inputLen = 0; //nothing more is handled
+        } else if (session->inputLen == MAX_LINE) {
+            return false; //line too long to be a word
+        }
+    }
+}
+
+/* session_flush()
+* −−−−−−−−−−−−−−−
+* Sends as much waiting output to the player as the connection takes
+*
+* session: session of the player
+*
+* Returns: boolean if the connection is still open
+*/
+bool session_flush(Session* session) {
+    while (session->outputSent < session->outputLen) {
+        ssize_t sent = write(session->fd, session->output
+                + session->outputSent, session->outputLen
+                - session->outputSent);
+        if (sent < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        session->outputSent += sent;
+    }
+    session->outputLen = 0;
+    session->outputSent = 0;
+    return true;
+}
+
+/* snapshot_load()
+* −−−−−−−−−−−−−−−
+* Loads a snapshot of the dictionary of every word length, ready for games
+*
+* data: options the dictionary is loaded with
+*
+* Returns: new snapshot or NULL if the dictionary can't be read
+*/
+Snapshot* snapshot_load(const Data* data) {
+    Snapshot* snapshot = stats_calloc(1, sizeof(Snapshot));
+    //the server reloads while the file may be rewritten, so it reads it
+    if (load_words(data, snapshot->dicts, MIN_LENGTH, MAX_LENGTH, false)
+            == false) {
+        free(snapshot);
+        return NULL;
+    }
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        find_starts(&snapshot->dicts[length]);
+    }
+    return snapshot;
+}
+
+/* snapshot_free()
+* −−−−−−−−−−−−−−−
+* Frees a snapshot no game is using
+*
+* snapshot: snapshot to free
+*
+* Returns: Nothing
+*/
+void snapshot_free(Snapshot* snapshot) {
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        free_dict(&snapshot->dicts[length]);
+    }
+    free(snapshot);
+}
+
+/* snapshot_release()
+* −−−−−−−−−−−−−−−
+* Ends one game's use of a snapshot, freeing it if it has been replaced
+* and was the last game on it
+*
+* snapshot: snapshot the game started on
+*
+* Returns: Nothing
+*/
+void snapshot_release(Snapshot* snapshot) {
+    snapshot->games--;
+    if (snapshot->retired == true && snapshot->games == 0) {
+        snapshot_free(snapshot);
+    }
+}
+
+/* reload_signal()
+* −−−−−−−−−−−−−−−
+* SIGHUP handler asking the server to reload the dictionary. It only wakes
+* the server, which is all that is safe in a handler.
+*
+* signum: signal caught
+*
+* Returns: Nothing
+*/
+void reload_signal(int signum) {
+    int saved = errno;
+    char asked = RELOAD_ASKED;
+    if (write(reload.pipe[1], &asked, 1) == -1) {
+        //a full pipe already holds a wake up
+    }
+    errno = saved;
+}
+
+/* reload_worker()
+* −−−−−−−−−−−−−−−
+* Thread loading a new snapshot and publishing it with an atomic swap, so
+* the server never waits on it. The snapshot replaced is handed back to the
+* server, which frees it once no game is left on it.
+*
+* arg: NULL
+*
+* Returns: NULL
+*/
+void* reload_worker(void* arg) {
+    Snapshot* fresh = snapshot_load(reload.data);
+    reload.replaced = NULL;
+    if (fresh == NULL) {
+        fprintf(stderr, FILE_NOT_OPENING, reload.data->dict);
+    } else {
+        reload.replaced = __atomic_exchange_n(&reload.current, fresh,
+                __ATOMIC_ACQ_REL);
+    }
+    //the pipe orders replaced before the server reads it
+    char done = RELOAD_DONE;
+    if (write(reload.pipe[1], &done, 1) == -1) {
+        fprintf(stderr, "%s\n", strerror(errno));
+    }
+    return NULL;
+}
+
+/* reload_start()
+* −−−−−−−−−−−−−−−
+* Starts a loader thread, or has the next one start after the running one
+*
+* Returns: Nothing
+*/
+void reload_start(void) {
+    pthread_t loader;
+    if (reload.loading == true) {
+        reload.again = true;
+    } else if (pthread_create(&loader, NULL, reload_worker, NULL) == 0) {
+        pthread_detach(loader);
+        reload.loading = true;
+    }
+}
+
+/* reload_event()
+* −−−−−−−−−−−−−−−
+* Handles the bytes on the reload pipe: starting a reload on SIGHUP and
+* retiring the snapshot a finished reload replaced
+*
+* Returns: Nothing
+*/
+void reload_event(void) {
+    char message;
+    while (read(reload.pipe[0], &message, 1) == 1) {
+        if (message == RELOAD_ASKED) {
+            reload_start();
+            continue;
+        }
+        reload.loading = false;
+        if (reload.replaced != NULL) {
+            reload.replaced->retired = true;
+            if (reload.replaced->games == 0) {
+                snapshot_free(reload.replaced);
+            }
+        }
+        if (reload.again == true) {
+            reload.again = false;
+            reload_start();
+        }
+    }
+}
+
+/* session_open()
+* −−−−−−−−−−−−−−−
+* Starts a session for a new connection, reusing a closed one if any are
+* free
+*
+* fd: connection to the player
+*
+* Returns: session of the player
+*/
+Session* session_open(int fd) {
+    Session* session = freeSessions;
+    if (session != NULL) {
+        freeSessions = session->next;
+        freeSessionCount--;
+    } else {
+        session = stats_calloc(1, sizeof(Session));
+        //unbuffered, so everything printed is in output straight away
+        cookie_io_functions_t functions = {NULL, session_write, NULL, NULL};
+        session->out = fopencookie(session, "w", functions);
+        setvbuf(session->out, NULL, _IONBF, 0);
+    }
+    session->fd = fd;
+    session->started = false;
+    session->closing = false;
+    session->snapshot = NULL;
+    session->inputLen = 0;
+    session->outputLen = 0;
+    session->outputSent = 0;
+    return session;
+}
+
+/* session_close()
+* −−−−−−−−−−−−−−−
+* Ends the game of a player and closes their connection. The session goes
+* on the free list, its arena to be reset by the next game, unless
+* FREE_SESSIONS are already waiting there.
+*
+* session: session of the player
+*
+* Returns: Nothing
+*/
+void session_close(Session* session) {
+    close(session->fd);
+    if (session->snapshot != NULL) {
+        snapshot_release(session->snapshot);
+    }
+    if (freeSessionCount < FREE_SESSIONS) {
+        session->next = freeSessions;
+        freeSessions = session;
+        freeSessionCount++;
+        return;
+    }
+    fclose(session->out);
+    game_free(&session->game);
+    free(session->output);
+    free(session);
+}
+
+/* server_listen()
+* −−−−−−−−−−−−−−−
+* Listens for players on a Unix domain socket, replacing any old socket
+* left at the path
+*
+* path: location of the socket
+*
+* Returns: listening socket or -1 if it can't be made
+*/
+int server_listen(const char* path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+    struct stat info;
+    if (stat(path, &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(path);
+    }
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listener == -1 || bind(listener, (struct sockaddr*)&address,
+            sizeof(address)) == -1 || listen(listener, LISTEN_BACKLOG)
+            == -1) {
+        if (listener != -1) {
+            close(listener);
+        }
+        return -1;
+    }
+    return listener;
+}
+
+/* server_accept()
+* −−−−−−−−−−−−−−−
+* Starts a session for every player waiting to connect. With no file
+* descriptors left, the spare one is given up to accept a player and hang
+* up on them, as a player left waiting would wake the listener again at
+* once, forever.
+*
+* listener: listening socket
+* poll: epoll instance watching every connection
+* spare: descriptor kept open for running out, -1 if it couldn't be
+*
+* Returns: Nothing
+*/
+void server_accept(int listener, int poll, int* spare) {
+    while (true) {
+        int fd = accept(listener, NULL, NULL);
+        if (fd == -1 && (errno == EINTR || errno == ECONNABORTED)) {
+            continue;
+        } else if (fd == -1 && (errno == EMFILE || errno == ENFILE)
+                && *spare != -1) {
+            close(*spare);
+            fd = accept(listener, NULL, NULL);
+            if (fd != -1) {
+                close(fd);
+            }
+            *spare = open(SPARE_FILE, O_RDONLY);
+            if (fd == -1) {
+                return;
+            }
+            continue;
+        } else if (fd == -1) {
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        Session* session = session_open(fd);
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = session;
+        if (epoll_ctl(poll, EPOLL_CTL_ADD, fd, &event) == -1) {
+            session_close(session);
+        }
+    }
+}
+
+/* server_event()
+* −−−−−−−−−−−−−−−
+* Handles the connection of one player becoming readable or writable
+*
+* session: session of the player
+* events: epoll events of the connection
+* poll: epoll instance watching every connection
+* snapshot: dictionaries new games start on
+*
+* Returns: Nothing
+*/
+void server_event(Session* session, unsigned int events, int poll,
+        Snapshot* snapshot) {
+    bool open = true;
+    if (session->closing == false && (events & (EPOLLIN | EPOLLHUP
+            | EPOLLERR))) {
+        open = session_read(session, snapshot);
+    }
+    open = open && session_flush(session);
+    if (open == false || (session->closing == true
+            && session->outputLen == 0)) {
+        epoll_ctl(poll, EPOLL_CTL_DEL, session->fd, NULL);
+        session_close(session);
+        return;
+    }
+    //only waits to write while output is held up
+    struct epoll_event event;
+    event.events = (session->closing ? 0 : EPOLLIN)
+            | (session->outputLen > 0 ? EPOLLOUT : 0);
+    event.data.ptr = session;
+    epoll_ctl(poll, EPOLL_CTL_MOD, session->fd, &event);
+}
+
+/* run_server()
+* −−−−−−−−−−−−−−−
+* Serves games to many players at once over a Unix domain socket. Every
+* dictionary length is loaded once up front and shared by all the games,
+* which each only keep their own moves. SIGHUP reloads the dictionary in
+* the background for new games, games in progress keep their own.
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if game options are given, the
+* dictionary can't be read or the socket can't be listened on
+*/
+void run_server(Data* data) {
+    if (data->initWordSet || data->toWordSet || data->wordLenSet
+            || data->stepLimSet || data->solve || data->batch != NULL
+            || data->analyze || data->edit || data->count || data->embed) {
+        error_exit(USAGE_ERROR, USAGE_ERROR_CODE, data);
+    }
+    if (data->dictSet == false) {
+        data->dict = DEF_DICT;
+    }
+    reload.data = data;
+    reload.current = snapshot_load(data);
+    if (reload.current == NULL) {
+        fprintf(stderr, FILE_NOT_OPENING, data->dict);
+        my_exit(FILE_ERROR_CODE, data);
+    }
+    int listener = server_listen(data->server);
+    if (listener == -1 || pipe(reload.pipe) == -1) {
+        fprintf(stderr, SERVER_ERROR, data->server);
+        my_exit(SERVER_ERROR_CODE, data);
+    }
+    for (int end = 0; end < 2; end++) {
+        fcntl(reload.pipe[end], F_SETFL,
+                fcntl(reload.pipe[end], F_GETFL) | O_NONBLOCK);
+    }
+    signal(SIGPIPE, SIG_IGN);
+    struct sigaction hangup;
+    memset(&hangup, 0, sizeof(hangup));
+    hangup.sa_handler = reload_signal;
+    hangup.sa_flags = SA_RESTART;
+    sigaction(SIGHUP, &hangup, NULL);
+    int poll = epoll_create1(0);
+    //given up by server_accept() if every other descriptor is taken
+    int spare = open(SPARE_FILE, O_RDONLY);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    epoll_ctl(poll, EPOLL_CTL_ADD, listener, &event);
+    event.data.ptr = &reload;
+    epoll_ctl(poll, EPOLL_CTL_ADD, reload.pipe[0], &event);
+    struct epoll_event events[MAX_EVENTS];
+    while (true) {
+        int ready = epoll_wait(poll, events, MAX_EVENTS, -1);
+        for (int i = 0; i < ready; i++) {
+            //games only ever read their snapshot, so none of them locks
+            Snapshot* snapshot = __atomic_load_n(&reload.current,
+                    __ATOMIC_ACQUIRE);
+            if (events[i].data.ptr == NULL) {
+                server_accept(listener, poll, &spare);
+            } else if (events[i].data.ptr == &reload) {
+                reload_event();
+            } else {
+                server_event(events[i].data.ptr, events[i].events, poll,
+                        snapshot);
+            }
+        }
+    }
+}
+
+/* batch_game()
+* −−−−−−−−−−−−−−−
+* Replays one game record: an options line as sent to the server, then a
+* tab and the moves separated by spaces. Game messages are discarded and
+* one result line is printed for the record.
+*
+* line: game record without its newline, split up in place
+* record: number of the record in the file
+* dicts: shared dictionary of each word length
+* game: game restarted for the record, its arena is reused
+* discard: stream the game messages are printed to
+*
+* Returns: Nothing
+*/
+void batch_game(char* line, int record, const Dict dicts[], Game* game,
+        FILE* discard) {
+    char* moves = strchr(line, '\t');
+    if (moves != NULL) {
+        *moves++ = '\0';
+    }
+    Data options;
+    set_false(&options);
+    if (session_options(line, &options) != NULL) {
+        fprintf(stdout, BATCH_RESULT, record, "invalid", 0, "-", "-");
+        return;
+    }
+    game_init(game, &dicts[options.wordLen], options.stepLim, discard);
+    if (option_words(game, &options) == false) {
+        fprintf(stdout, BATCH_RESULT, record, "nopuzzle", 0, "-", "-");
+        return;
+    }
+    char* save = NULL;
+    for (char* move = moves == NULL ? NULL : strtok_r(moves, " ", &save);
+            move != NULL && game->result == GAME_PLAYING;
+            move = strtok_r(NULL, " ", &save)) {
+        make_caps(move);
+        check_input(move, game);
+    }
+    //a game that ran out of moves is still on the attempt it ended on
+    if (game->result == 0 || game->result == GAME_LOST_CODE) {
+        fprintf(stdout, BATCH_RESULT, record, game->result == 0 ? "won"
+                : "lost", game->attempt, game->initWord, game->toWord);
+    } else {
+        fprintf(stdout, BATCH_RESULT, record, "gaveup", game->attempt - 1,
+                game->initWord, game->toWord);
+    }
+}
+
+/* run_batch()
+* −−−−−−−−−−−−−−−
+* Replays every game record in a file against dictionaries loaded once,
+* printing a tab separated result line per game: record number, result
+* (won, lost, gaveup, invalid or nopuzzle), steps taken, initial word and
+* target word. Output is fully buffered and the throughput is reported on
+* stderr at the end.
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if game options are given or the
+* batch or dictionary file can't be read
+*/
+void run_batch(Data* data) {
+    if (data->initWordSet || data->toWordSet || data->wordLenSet
+            || data->stepLimSet || data->solve || data->analyze
+            || data->edit || data->count || data->embed) {
+        error_exit(USAGE_ERROR, USAGE_ERROR_CODE, data);
+    }
+    if (data->dictSet == false) {
+        data->dict = DEF_DICT;
+    }
+    FILE* file = fopen(data->batch, "r");
+    if (file == NULL) {
+        fprintf(stderr, FILE_NOT_OPENING, data->batch);
+        my_exit(FILE_ERROR_CODE, data);
+    }
+    if (load_words(data, data->dicts, MIN_LENGTH, MAX_LENGTH, true)
+            == false) {
+        fclose(file);
+        fprintf(stderr, FILE_NOT_OPENING, data->dict);
+        my_exit(FILE_ERROR_CODE, data);
+    }
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        find_starts(&data->dicts[length]);
+    }
+    FILE* discard = fopen("/dev/null", "w");
+    setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER);
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    char* line = NULL;
+    size_t lineSize = 0;
+    int games = 0;
+    //one game is restarted for every record so its arena is reused
+    while (getline(&line, &lineSize, file) != -1) {
+        line[strcspn(line, "\r\n")] = '\0';
+        batch_game(line, ++games, data->dicts, &data->game, discard);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    free(line);
+    fclose(file);
+    fclose(discard);
+    double seconds = (end.tv_sec - start.tv_sec)
+            + (end.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr, BATCH_SUMMARY, games, seconds,
+            seconds > 0 ? games / seconds : 0);
+    fflush(stdout);
+    my_exit(0, data);
+}
+
+/* embed_array()
+* −−−−−−−−−−−−−−−
+* Writes one table of the compiled in dictionary as C source. A zero is
+* added to the end so no table is ever empty.
+*
+* type: C type of the values
+* name: name of the table
+* length: word length the table belongs to
+* values: values of the table, uint64_t or int
+* size: size of each value
+* count: number of values
+*
+* Returns: Nothing
+*/
+void embed_array(const char* type, const char* name, unsigned int length,
+        const void* values, size_t size, int count) {
+    fprintf(stdout, "static const %s %s%u[] = {", type, name, length);
+    for (int i = 0; i < count; i++) {
+        const char* space = i % EMBED_PER_LINE ? " " : "\n    ";
+        //int tables hold EMPTY_SLOT, so they are written signed
+        if (size == sizeof(uint64_t)) {
+            fprintf(stdout, "%s%llu,", space,
+                    (unsigned long long)((const uint64_t*)values)[i]);
+        } else {
+            fprintf(stdout, "%s%d,", space, ((const int*)values)[i]);
+        }
+    }
+    fprintf(stdout, "\n    0\n};\n");
+}
+
+/* embed_index()
+* −−−−−−−−−−−−−−−
+* Writes the table pointing to each word length's table of one kind
+*
+* type: C type of the pointers
+* name: name of the per length tables
+*
+* Returns: Nothing
+*/
+void embed_index(const char* type, const char* name) {
+    fprintf(stdout, "static const %s const %s[MAX_LENGTH + 1] = {\n", type,
+            name);
+    for (int length = 0; length <= MAX_LENGTH; length++) {
+        if (length < MIN_LENGTH) {
+            fprintf(stdout, "    NULL,\n");
+        } else {
+            fprintf(stdout, "    %s%d,\n", name, length);
+        }
+    }
+    fprintf(stdout, "};\n");
+}
+
+/* run_embed()
+* −−−−−−−−−−−−−−−
+* Writes the dictionary of every word length to stdout as C source, to be
+* saved as EMBED_SOURCE and compiled in with -DEMBED_DICT. The source holds
+* the same sorted codes and neighbour graph the cache does, so nothing is
+* worked out when the program starts.
+*
+* data: Struct containing all the data for the game.
+*
+* Returns: Nothing
+* Errors: Error message prints and exits if game options are given or the
+* dictionary can't be read
+*/
+void run_embed(Data* data) {
+    if (data->initWordSet || data->toWordSet || data->wordLenSet
+            || data->stepLimSet || data->solve || data->analyze
+            || data->edit || data->count) {
+        error_exit(USAGE_ERROR, USAGE_ERROR_CODE, data);
+    }
+    if (data->dictSet == false) {
+        data->dict = DEF_DICT;
+    }
+    //always the file, never a dictionary already compiled in
+    if (load_dictionaries(data->dicts, data->dict, MIN_LENGTH, MAX_LENGTH,
+            true) == false) {
+        fprintf(stderr, FILE_NOT_OPENING, data->dict);
+        my_exit(FILE_ERROR_CODE, data);
+    }
+    setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER);
+    fprintf(stdout, EMBED_HEADER, data->dict);
+    fprintf(stdout, "static const int embeddedWords[MAX_LENGTH + 1] = {");
+    for (int length = 0; length <= MAX_LENGTH; length++) {
+        fprintf(stdout, "%d%s", data->dicts[length].wordsInDict,
+                length < MAX_LENGTH ? ", " : "};\n");
+    }
+    for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+        const Dict* dict = &data->dicts[length];
+        int words = dict->wordsInDict;
+        embed_array("uint64_t", "embeddedCodes", length, dict->codes,
+                sizeof(uint64_t), words);
+        embed_array("int", "embeddedIndex", length, dict->index,
+                sizeof(int), index_size(words));
+        embed_array("uint64_t", "embeddedIndexCodes", length,
+                dict->indexCodes, sizeof(uint64_t), index_size(words));
+        embed_array("int", "embeddedNeighStart", length, dict->neighStart,
+                sizeof(int), words + 1);
+        embed_array("int", "embeddedNeighbours", length, dict->neighbours,
+                sizeof(int), dict->neighStart[words]);
+    }
+    embed_index("uint64_t*", "embeddedCodes");
+    embed_index("int*", "embeddedIndex");
+    embed_index("uint64_t*", "embeddedIndexCodes");
+    embed_index("int*", "embeddedNeighStart");
+    embed_index("int*", "embeddedNeighbours");
+    my_exit(0, data);
 }
 
 int main(int argc, char* argv[]) {
     Data data;
-    data = set_false(data);
-    data = check_command_line(data, argc, argv);
-    data = length_check(data);
-    data = word_check(data);
-    data = step_check(data);
-    data = read_dictionary(data);
+    set_false(&data);
+    stats.startNs = stats_now();
+    //an empty or "0" value turns stats off, as if it wasn't set
+    const char* statsEnv = getenv(STATS_ENV);
+    stats.enabled = statsEnv != NULL && statsEnv[0] != '\0'
+            && strcmp(statsEnv, "0") != 0;
+    check_command_line(&data, argc, argv);
+    srand(time(NULL) ^ getpid());
+    if (data.server != NULL) {
+        run_server(&data);
+    }
+    if (data.batch != NULL) {
+        run_batch(&data);
+    }
+    if (data.analyze == true) {
+        run_analysis(&data);
+    }
+    if (data.embed == true) {
+        run_embed(&data);
+    }
+    length_check(&data);
+    word_check(&data);
+    step_check(&data);
+    if (data.solve == false && data.count == false && data.initWordSet == true
+            && data.toWordSet == true) {
+        //nothing is picked from the dictionary, so it loads during play
+        start_loading(&data);
+        fprintf(stdout, WELCOME, data.initWord, data.toWord, data.stepLim);
+        game_loop(&data);
+    }
+    read_dictionary(&data);
+    generate_words(&data);
+    if (data.solve == true) {
+        my_exit(solve_ladder(&data.game), &data);
+    }
+    if (data.count == true) {
+        my_exit(count_ladders(&data.game, data.ladders), &data);
+    }
     //Welcome message
-    fprintf(stdout, WELCOME, data.initWord, data.toWord, data.stepLim);
+    fprintf(stdout, WELCOME, data.game.initWord, data.game.toWord,
+            data.game.stepLim);
     //starts loop
-    game_loop(data);
+    game_loop(&data);
 }
\ No newline at end of file